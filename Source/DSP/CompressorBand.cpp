@@ -9,6 +9,7 @@
 */
 
 #include "CompressorBand.h"
+#include "Params.h"
 
 void CompressorBand::prepare(const juce::dsp::ProcessSpec& spec)
 {
@@ -20,12 +21,14 @@ void CompressorBand::updateCompressorSettings()
     compressor.setAttack(attack->get());
     compressor.setRelease(release->get());
     compressor.setThreshold(threshold->get());
-    compressor.setRatio(ratio->getCurrentChoiceName().getFloatValue());
+    //the choice index straight into the table the choices were made from: no Strings on the audio thread.
+    compressor.setRatio((float)Params::RatioChoices[(size_t)ratio->getIndex()]);
 }
 
 void CompressorBand::process(juce::AudioBuffer<float>& buffer)
 {
     auto preRMS = computeRMSLevel(buffer);
+    auto prePeak = computePeakLevel(buffer);
     auto block = juce::dsp::AudioBlock<float>(buffer);
     auto context = juce::dsp::ProcessContextReplacing<float>(block);
 
@@ -33,13 +36,19 @@ void CompressorBand::process(juce::AudioBuffer<float>& buffer)
 
     compressor.process(context);
     auto postRMS = computeRMSLevel(buffer);
+    auto postPeak = computePeakLevel(buffer);
 
     auto convertToDb = [](auto input)
     {
         return juce::Decibels::gainToDecibels(input);
     };
 
-    rmsInputLeveldB.store(convertToDb(preRMS));
-    rmsOutputLeveldB.store(convertToDb(postRMS));
+    lastReading.inputRMSdB = convertToDb(preRMS);
+    lastReading.outputRMSdB = convertToDb(postRMS);
+    lastReading.inputPeakdB = convertToDb(prePeak);
+    lastReading.outputPeakdB = convertToDb(postPeak);
+
+    rmsInputLeveldB.store(lastReading.inputRMSdB);
+    rmsOutputLeveldB.store(lastReading.outputRMSdB);
 
 }
\ No newline at end of file
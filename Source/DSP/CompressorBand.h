@@ -11,6 +11,7 @@
 #pragma once
 #include <JuceHeader.h>
 #include "../GUI/Utilities.h"
+#include "MeterFrameRing.h"
 
 struct CompressorBand
 {
@@ -30,12 +31,17 @@ struct CompressorBand
 
     float getRMSOutputLeveldB() const { return rmsOutputLeveldB; }
     float getRMSInputLeveldB() const { return rmsInputLeveldB; }
+
+    //the levels from the last process() call. audio thread only.
+    const BandMeterReading& getLastReading() const { return lastReading; }
 private:
     juce::dsp::Compressor<float> compressor;
 
     std::atomic<float> rmsInputLeveldB {NEGATIVE_INFINITY};
     std::atomic<float> rmsOutputLeveldB {NEGATIVE_INFINITY};
 
+    BandMeterReading lastReading;
+
     template<typename T>
     float computeRMSLevel(const T& buffer)
     {
@@ -50,4 +56,14 @@ private:
         return rms;
 
     }
+
+    template<typename T>
+    float computePeakLevel(const T& buffer)
+    {
+        auto peak = 0.f;
+        for (int chan = 0; chan < buffer.getNumChannels(); ++chan)
+            peak = juce::jmax(peak, buffer.getMagnitude(chan, 0, buffer.getNumSamples()));
+
+        return peak;
+    }
 };
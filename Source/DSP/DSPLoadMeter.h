@@ -0,0 +1,96 @@
+/*
+  ==============================================================================
+
+    DSPLoadMeter.h
+    Created: 19 Oct 2026 11:24:09pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+
+/*
+ how much of each block's deadline (numSamples / sampleRate) processBlock() used.
+
+ the audio thread is the only writer of the running totals, so it only ever does relaxed
+ loads and stores; the editor reads them and works out averages from the difference between
+ two snapshots. the peak is the one value both sides write: the editor takes it with
+ exchange(0) so it reads as "the worst block since I last looked".
+ */
+struct DSPLoadMeter
+{
+    //call before processing starts, i.e. from prepareToPlay().
+    void prepare(double sampleRate)
+    {
+        ticksPerSecond = (double)juce::Time::getHighResolutionTicksPerSecond();
+        secondsPerSample.store(sampleRate > 0.0 ? 1.0 / sampleRate : 0.0, std::memory_order_relaxed);
+    }
+
+    struct ScopedMeasurement
+    {
+        ScopedMeasurement(DSPLoadMeter& meterToUse, int numSamplesInBlock) :
+            meter(meterToUse),
+            numSamples(numSamplesInBlock),
+            startTicks(juce::Time::getHighResolutionTicks())
+        { }
+
+        ~ScopedMeasurement()
+        {
+            meter.addBlock(juce::Time::getHighResolutionTicks() - startTicks, numSamples);
+        }
+    private:
+        DSPLoadMeter& meter;
+        int numSamples;
+        juce::int64 startTicks;
+    };
+
+    struct Totals
+    {
+        juce::uint64 numBlocks = 0;
+        double loadSum = 0.0;       //sum of every block's load, 1.0 being the whole deadline
+        juce::uint64 numOverruns = 0;
+    };
+
+    //any thread. the three totals can be a block apart from each other, which is fine for a display.
+    Totals getTotals() const
+    {
+        Totals totals;
+        totals.numBlocks = numBlocks.load(std::memory_order_relaxed);
+        totals.loadSum = loadSum.load(std::memory_order_relaxed);
+        totals.numOverruns = numOverruns.load(std::memory_order_relaxed);
+        return totals;
+    }
+
+    //the highest load since the last call, reset to 0.
+    float takePeakLoad() { return peakLoad.exchange(0.f, std::memory_order_relaxed); }
+private:
+    double ticksPerSecond = 1.0;
+    std::atomic<double> secondsPerSample{ 0.0 };
+
+    std::atomic<juce::uint64> numBlocks{ 0 }, numOverruns{ 0 };
+    std::atomic<double> loadSum{ 0.0 };
+    std::atomic<float> peakLoad{ 0.f };
+
+    void addBlock(juce::int64 elapsedTicks, int numSamples)
+    {
+        const auto deadline = numSamples * secondsPerSample.load(std::memory_order_relaxed);
+        if (deadline <= 0.0)
+            return;
+
+        const auto load = (double)elapsedTicks / ticksPerSecond / deadline;
+
+        //single writer: a load and a store is all an increment needs.
+        numBlocks.store(numBlocks.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        loadSum.store(loadSum.load(std::memory_order_relaxed) + load, std::memory_order_relaxed);
+
+        if (load > 1.0)
+            numOverruns.store(numOverruns.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        auto peak = peakLoad.load(std::memory_order_relaxed);
+        while ((float)load > peak && !peakLoad.compare_exchange_weak(peak, (float)load, std::memory_order_relaxed))
+        { }
+    }
+};
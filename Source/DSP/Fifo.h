@@ -10,17 +10,48 @@
 
 #pragma once
 #include <JuceHeader.h>
-#include <array>
+#include <vector>
 
+/*
+ single producer, single consumer queue of preallocated T's.
+ 'maxCapacity' is the most items it can ever hold: the slots are allocated once here and never
+ move, so a reader that races a setCapacity() still only touches valid storage.
+ size the capacity from how far the consumer can fall behind, every slot is a full T (a whole
+ buffer or spectrum).
+ */
 template<typename T>
 struct Fifo
 {
+    explicit Fifo(int maxCapacity)
+    {
+        jassert(maxCapacity > 0);
+
+        //AbstractFifo keeps one slot free to tell full from empty.
+        buffers.resize((size_t)maxCapacity + 1);
+        setCapacity(maxCapacity);
+    }
+
+    //only changes how many of the slots are used. drops anything queued, so only call it
+    //when nothing else is pushing or pulling.
+    void setCapacity(int capacity)
+    {
+        jassert(capacity > 0 && capacity <= getMaxCapacity());
+        capacity = juce::jlimit(1, getMaxCapacity(), capacity);
+
+        fifo.setTotalSize(capacity + 1);
+    }
+
+    int getMaxCapacity() const { return (int)buffers.size() - 1; }
+    int getCapacity() const { return fifo.getTotalSize() - 1; }
+
+    //not thread safe: the slots in use may reallocate, so nothing else can be pushing or pulling.
     void prepare(int numChannels, int numSamples)
     {
         static_assert(std::is_same_v<T, juce::AudioBuffer<float>>,
             "prepare(numChannels, numSamples) should only be used when the Fifo is holding juce::AudioBuffer<float>");
-        for (auto& buffer : buffers)
+        for (int i = 0; i < fifo.getTotalSize(); ++i)
         {
+            auto& buffer = buffers[(size_t)i];
             buffer.setSize(numChannels,
                 numSamples,
                 false,   //clear everything?
@@ -34,13 +65,15 @@ struct Fifo
     {
         static_assert(std::is_same_v<T, std::vector<float>>,
             "prepare(numElements) should only be used when the Fifo is holding std::vector<float>");
-        for (auto& buffer : buffers)
+        for (int i = 0; i < fifo.getTotalSize(); ++i)
         {
+            auto& buffer = buffers[(size_t)i];
             buffer.clear();
             buffer.resize(numElements, 0);
         }
     }
 
+    //if the fifo is full 't' is dropped.
     bool push(const T& t)
     {
         auto write = fifo.write(1);
@@ -53,6 +86,29 @@ struct Fifo
         return false;
     }
 
+    /*
+     for display data, where the newest frame matters most: if the fifo is full the oldest
+     item is dropped to make room. only safe when push and pull happen on the same thread.
+     */
+    void pushLatest(const T& t)
+    {
+        makeRoomForLatest();
+        push(t);
+    }
+
+    //the same, copying 'numElements' floats into a slot instead of a whole vector.
+    void pushLatest(const float* data, size_t numElements)
+    {
+        static_assert(std::is_same_v<T, std::vector<float>>,
+            "pushLatest(data, numElements) should only be used when the Fifo is holding std::vector<float>");
+
+        makeRoomForLatest();
+
+        auto write = fifo.write(1);
+        if (write.blockSize1 > 0)
+            buffers[write.startIndex1].assign(data, data + numElements);
+    }
+
     bool pull(T& t)
     {
         auto read = fifo.read(1);
@@ -69,8 +125,19 @@ struct Fifo
     {
         return fifo.getNumReady();
     }
+
+    //not thread safe: only call when nothing else is pushing or pulling.
+    void reset()
+    {
+        fifo.reset();
+    }
 private:
-    static constexpr int Capacity = 30;
-    std::array<T, Capacity> buffers;
-    juce::AbstractFifo fifo{ Capacity };
+    std::vector<T> buffers;
+    juce::AbstractFifo fifo{ 2 };
+
+    void makeRoomForLatest()
+    {
+        if (fifo.getFreeSpace() == 0)
+            fifo.finishedRead(1);
+    }
 };
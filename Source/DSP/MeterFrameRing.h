@@ -0,0 +1,74 @@
+/*
+  ==============================================================================
+
+    MeterFrameRing.h
+    Created: 19 Oct 2026 6:22:47pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "../GUI/Utilities.h"
+
+//one band's levels over one processBlock() call.
+struct BandMeterReading
+{
+    float inputRMSdB = NEGATIVE_INFINITY;
+    float outputRMSdB = NEGATIVE_INFINITY;
+    float inputPeakdB = NEGATIVE_INFINITY;
+    float outputPeakdB = NEGATIVE_INFINITY;
+
+    float getGainReductiondB() const { return outputRMSdB - inputRMSdB; }
+};
+
+struct MeterFrame
+{
+    std::array<BandMeterReading, 3> bands;
+    int numSamples = 0;
+};
+
+/*
+ single producer (audio thread), single consumer (message thread) ring of MeterFrames.
+ push() never blocks or allocates: if the reader falls behind, new frames are dropped.
+ sized for a couple of seconds of 16 sample blocks at 48kHz, far more than one editor frame needs.
+ */
+struct MeterFrameRing
+{
+    bool push(const MeterFrame& frame)
+    {
+        auto write = fifo.write(1);
+        if (write.blockSize1 > 0)
+        {
+            frames[write.startIndex1] = frame;
+            return true;
+        }
+
+        return false;
+    }
+
+    //calls 'func' with every waiting frame, oldest first. returns how many there were.
+    template<typename Func>
+    int pullAll(Func&& func)
+    {
+        auto read = fifo.read(fifo.getNumReady());
+
+        for (int i = 0; i < read.blockSize1; ++i)
+            func(frames[read.startIndex1 + i]);
+
+        for (int i = 0; i < read.blockSize2; ++i)
+            func(frames[read.startIndex2 + i]);
+
+        return read.blockSize1 + read.blockSize2;
+    }
+
+    //consumer side: drops whatever piled up while nothing was reading.
+    void discardAll() { pullAll([](const MeterFrame&) { }); }
+
+    static constexpr int capacity = 4096;
+private:
+    std::array<MeterFrame, capacity> frames;
+    juce::AbstractFifo fifo{ capacity };
+};
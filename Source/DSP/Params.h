@@ -10,9 +10,12 @@
 
 #pragma once
 #include <JuceHeader.h>
+#include <array>
+#include <map>
 
 namespace Params
 {
+    //only ever append to this: StateFormat saves the values in this order.
     enum Names
     {
         Low_Mid_Crossover_Freq,
@@ -47,39 +50,94 @@ namespace Params
         Solo_High_Band,
 
         Gain_In,
-        Gain_Out
+        Gain_Out,
+
+        NumParams
     };
 
+    //indexed by Names. these are also the parameter IDs, so they can never change.
+    inline constexpr std::array<const char*, NumParams> ParamIDs
+    {
+        "Low-Mid Crossover Freq",
+        "Mid-High Crossover Freq",
+        "Threshold Low Band",
+        "Threshold Mid Band",
+        "Threshold High Band",
+        "Attack Low Band",
+        "Attack Mid Band",
+        "Attack High Band",
+        "Release Low Band",
+        "Release Mid Band",
+        "Release High Band",
+        "Ratio Low Band",
+        "Ratio Mid Band",
+        "Ratio High Band",
+        "Bypass Low Band",
+        "Bypass Mid Band",
+        "Bypass High Band",
+        "Mute Low Band",
+        "Mute Mid Band",
+        "Mute High Band",
+        "Solo Low Band",
+        "Solo Mid Band",
+        "Solo High Band",
+        "Gain In",
+        "Gain Out"
+    };
+
+    static_assert(ParamIDs[NumParams - 1] != nullptr, "every Names entry needs an ID");
+
     inline const std::map<Names, juce::String>& GetParams()
     {
-        static std::map<Names, juce::String> params =
-        {
-            { Low_Mid_Crossover_Freq, "Low-Mid Crossover Freq"} ,
-            { Mid_High_Crossover_Freq, "Mid-High Crossover Freq" },
-            { Threshold_Low_Band, "Threshold Low Band" },
-            { Threshold_Mid_Band, "Threshold Mid Band" },
-            { Threshold_High_Band, "Threshold High Band" },
-            { Attack_Low_band, "Attack Low Band" },
-            { Attack_Mid_band, "Attack Mid Band" },
-            { Attack_High_band, "Attack High Band" },
-            { Release_Low_Band, "Release Low Band" },
-            { Release_Mid_Band, "Release Mid Band" },
-            { Release_High_Band, "Release High Band" },
-            { Ratio_Low_Band, "Ratio Low Band" },
-            { Ratio_Mid_Band, "Ratio Mid Band" },
-            { Ratio_High_Band, "Ratio High Band" },
-            { Bypass_Low_Band, "Bypass Low Band" },
-            { Bypass_Mid_Band, "Bypass Mid Band" },
-            { Bypass_High_Band, "Bypass High Band" },
-            { Mute_Low_Band, "Mute Low Band" },
-            { Mute_Mid_Band, "Mute Mid Band" },
-            { Mute_High_Band, "Mute High Band" },
-            { Solo_Low_Band, "Solo Low Band" },
-            { Solo_Mid_Band, "Solo Mid Band" },
-            { Solo_High_Band, "Solo High Band" },
-            { Gain_In, "Gain In" },
-            { Gain_Out, "Gain Out" }
-        };
+        static const std::map<Names, juce::String> params = []()
+            {
+                std::map<Names, juce::String> m;
+                for (int i = 0; i < NumParams; ++i)
+                    m.emplace(static_cast<Names>(i), ParamIDs[i]);
+                return m;
+            }();
+
         return params;
     }
+
+    inline constexpr std::array<double, 15> RatioChoices{ 1, 1.5, 2, 3, 4, 5, 6, 7, 8, 10, 15, 20, 25, 50, 100 };
+
+    //built once per process rather than once per instance.
+    inline const juce::StringArray& GetRatioChoiceNames()
+    {
+        static const juce::StringArray names = []()
+            {
+                juce::StringArray sa;
+                for (auto choice : RatioChoices)
+                    sa.add(juce::String(choice, 1));
+                return sa;
+            }();
+
+        return names;
+    }
+
+    /*
+     typed pointers to every parameter, filled in while the layout is built,
+     so nothing has to look them up by ID or dynamic_cast them afterwards.
+     */
+    struct Registry
+    {
+        template<typename ParamType, typename... Args>
+        void add(juce::AudioProcessorValueTreeState::ParameterLayout& layout, Names name, Args&&... args)
+        {
+            auto param = std::make_unique<ParamType>(ParamIDs[name], ParamIDs[name], std::forward<Args>(args)...);
+            params[name] = param.get();
+            layout.add(std::move(param));
+        }
+
+        template<typename ParamType>
+        ParamType* get(Names name) const
+        {
+            auto* param = params[name];
+            jassert(dynamic_cast<ParamType*>(param) != nullptr);
+            return static_cast<ParamType*>(param);
+        }
+    private:
+        std::array<juce::RangedAudioParameter*, NumParams> params{};
+    };
 }
@@ -0,0 +1,179 @@
+/*
+  ==============================================================================
+
+    Profiling.cpp
+    Created: 19 Oct 2026 10:58:12pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "Profiling.h"
+
+#if SIMPLEMBCOMP_PROFILING
+
+namespace Profiling
+{
+namespace
+{
+    std::atomic<bool> recording{ false };
+
+    //rings live until exit: a thread can end while its events are still being written.
+    struct RingRegistry
+    {
+        juce::CriticalSection lock;
+        std::vector<std::unique_ptr<ThreadRing>> rings;
+    };
+
+    RingRegistry& getRegistry()
+    {
+        static RingRegistry registry;
+        return registry;
+    }
+
+    thread_local ThreadRing* threadRing = nullptr;
+}
+
+bool isRecording()
+{
+    return recording.load(std::memory_order_relaxed);
+}
+
+ThreadRing& getThreadRing()
+{
+    if (threadRing == nullptr)
+    {
+        auto& registry = getRegistry();
+        const juce::ScopedLock sl(registry.lock);
+
+        auto ring = std::make_unique<ThreadRing>();
+        ring->threadIndex = (int)registry.rings.size() + 1;
+
+        if (auto* thread = juce::Thread::getCurrentThread())
+            ring->threadName = thread->getThreadName();
+        else if (juce::MessageManager::getInstanceWithoutCreating() != nullptr
+                 && juce::MessageManager::getInstanceWithoutCreating()->isThisTheMessageThread())
+            ring->threadName = "message thread";
+        else
+            ring->threadName = "thread " + juce::String(ring->threadIndex);
+
+        threadRing = ring.get();
+        registry.rings.push_back(std::move(ring));
+    }
+
+    return *threadRing;
+}
+//==============================================================================
+TraceWriter::TraceWriter(const juce::File& file) :
+    juce::Thread("trace writer"),
+    outputFile(file)
+{
+}
+
+TraceWriter::~TraceWriter()
+{
+    stop();
+}
+
+bool TraceWriter::start()
+{
+    jassert(!isThreadRunning());
+
+    outputFile.deleteFile();
+    stream = std::make_unique<juce::FileOutputStream>(outputFile);
+    if (!stream->openedOk())
+    {
+        stream.reset();
+        return false;
+    }
+
+    *stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+
+    originTicks = juce::Time::getHighResolutionTicks();
+    numEventsWritten = 0;
+
+    //anything left over from an earlier run belongs to that run.
+    {
+        auto& registry = getRegistry();
+        const juce::ScopedLock sl(registry.lock);
+        for (auto& ring : registry.rings)
+        {
+            ring->pullAll([](const TraceEvent&) {});
+            ring->dropped.store(0);
+        }
+    }
+
+    recording.store(true);
+    startThread();
+    return true;
+}
+
+void TraceWriter::stop()
+{
+    if (stream == nullptr)
+        return;
+
+    recording.store(false);
+    stopThread(1000);
+
+    //whatever was pushed before recording stopped, plus a name for every thread seen.
+    drain();
+
+    auto& registry = getRegistry();
+    const juce::ScopedLock sl(registry.lock);
+    for (auto& ring : registry.rings)
+    {
+        *stream << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << ring->threadIndex
+                << ",\"args\":{\"name\":" << juce::JSON::toString(ring->threadName) << "}},\n";
+    }
+
+    //the trailing comma above would make the array invalid JSON.
+    *stream << "{\"name\":\"end\",\"ph\":\"i\",\"s\":\"g\",\"pid\":1,\"tid\":0,\"ts\":0}\n]}\n";
+    stream->flush();
+    stream.reset();
+}
+
+void TraceWriter::run()
+{
+    while (!threadShouldExit())
+    {
+        drain();
+        wait(50);
+    }
+}
+
+int TraceWriter::getNumEventsDropped() const
+{
+    auto& registry = getRegistry();
+    const juce::ScopedLock sl(registry.lock);
+
+    int dropped = 0;
+    for (auto& ring : registry.rings)
+        dropped += ring->dropped.load();
+
+    return dropped;
+}
+
+void TraceWriter::drain()
+{
+    auto& registry = getRegistry();
+    const juce::ScopedLock sl(registry.lock);
+
+    for (auto& ring : registry.rings)
+        ring->pullAll([this, &ring](const TraceEvent& event) { writeEvent(*ring, event); });
+}
+
+void TraceWriter::writeEvent(const ThreadRing& ring, const TraceEvent& event)
+{
+    const auto ticksPerMicrosecond = (double)juce::Time::getHighResolutionTicksPerSecond() / 1.0e6;
+    const auto ts = (double)(event.startTicks - originTicks) / ticksPerMicrosecond;
+    const auto dur = (double)(event.endTicks - event.startTicks) / ticksPerMicrosecond;
+
+    *stream << "{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << ring.threadIndex
+            << ",\"ts\":" << juce::String(ts, 3) << ",\"dur\":" << juce::String(dur, 3) << "},\n";
+
+    ++numEventsWritten;
+}
+}
+
+#endif
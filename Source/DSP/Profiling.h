@@ -0,0 +1,141 @@
+/*
+  ==============================================================================
+
+    Profiling.h
+    Created: 19 Oct 2026 10:58:12pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ scoped timers for the hot path, written to a lock-free ring per thread and streamed
+ to a Chrome trace_event JSON file (chrome://tracing, Perfetto) by a background thread.
+
+ compiled in only when SIMPLEMBCOMP_PROFILING is 1 (the headless tool's Profile configuration
+ sets it, so the other commands and the plugin build measure the code without it).
+ otherwise PROFILE_SCOPE expands to nothing and none of this exists.
+ */
+#ifndef SIMPLEMBCOMP_PROFILING
+ #define SIMPLEMBCOMP_PROFILING 0
+#endif
+
+#if SIMPLEMBCOMP_PROFILING
+
+#include <array>
+#include <atomic>
+
+namespace Profiling
+{
+    struct TraceEvent
+    {
+        const char* name = nullptr;   //a string literal: only the pointer is stored
+        juce::int64 startTicks = 0;
+        juce::int64 endTicks = 0;
+    };
+
+    /*
+     single producer (the thread it belongs to), single consumer (the TraceWriter).
+     if the writer falls behind new events are dropped and counted.
+     */
+    struct ThreadRing
+    {
+        static constexpr juce::uint32 capacity = 1 << 14;
+
+        void push(const TraceEvent& event)
+        {
+            auto write = writeIndex.load(std::memory_order_relaxed);
+            if (write - readIndex.load(std::memory_order_acquire) >= capacity)
+            {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            events[write % capacity] = event;
+            writeIndex.store(write + 1, std::memory_order_release);
+        }
+
+        template<typename Func>
+        int pullAll(Func&& func)
+        {
+            auto read = readIndex.load(std::memory_order_relaxed);
+            auto write = writeIndex.load(std::memory_order_acquire);
+
+            for (auto i = read; i != write; ++i)
+                func(events[i % capacity]);
+
+            readIndex.store(write, std::memory_order_release);
+            return (int)(write - read);
+        }
+
+        int threadIndex = 0;
+        juce::String threadName;
+        std::atomic<int> dropped{ 0 };
+    private:
+        std::array<TraceEvent, capacity> events;
+        std::atomic<juce::uint32> writeIndex{ 0 }, readIndex{ 0 };
+    };
+
+    //nothing is recorded unless a TraceWriter is running.
+    bool isRecording();
+
+    /*
+     the calling thread's ring. the first call on each thread allocates and takes a lock
+     to register it, so call this once from a thread before timing anything on it.
+     */
+    ThreadRing& getThreadRing();
+
+    struct ScopedTimer
+    {
+        explicit ScopedTimer(const char* scopeName) :
+            name(scopeName),
+            startTicks(isRecording() ? juce::Time::getHighResolutionTicks() : 0)
+        { }
+
+        ~ScopedTimer()
+        {
+            if (startTicks != 0)
+                getThreadRing().push({ name, startTicks, juce::Time::getHighResolutionTicks() });
+        }
+    private:
+        const char* name;
+        juce::int64 startTicks;
+    };
+
+    /*
+     drains every thread's ring on a background thread and streams the events to 'file'
+     as Chrome trace JSON. recording runs from start() until stop(), or until destruction.
+     */
+    struct TraceWriter : juce::Thread
+    {
+        explicit TraceWriter(const juce::File& file);
+        ~TraceWriter() override;
+
+        bool start();
+        void stop();
+
+        void run() override;
+
+        int getNumEventsWritten() const { return numEventsWritten; }
+        int getNumEventsDropped() const;
+    private:
+        juce::File outputFile;
+        std::unique_ptr<juce::FileOutputStream> stream;
+        juce::int64 originTicks = 0;
+        int numEventsWritten = 0;
+
+        void drain();
+        void writeEvent(const ThreadRing& ring, const TraceEvent& event);
+    };
+}
+
+#define PROFILE_SCOPE(name) Profiling::ScopedTimer JUCE_JOIN_MACRO(profileScope_, __LINE__)(name)
+
+#else
+
+#define PROFILE_SCOPE(name)
+
+#endif
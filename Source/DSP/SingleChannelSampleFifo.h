@@ -34,9 +34,13 @@ struct SingleChannelSampleFifo
         }
     }
 
-    void prepare(int bufferSize)
+    void prepare(int bufferSize, double sampleRate)
     {
+        //the slots are resized below, so wait for a read that's already started and block new ones.
         prepared.set(false);
+        while (readInProgress.get())
+            juce::Thread::yield();
+
         size.set(bufferSize);
 
         bufferToFill.setSize(1,             //channel
@@ -44,22 +48,46 @@ struct SingleChannelSampleFifo
             false,         //keepExistingContent
             true,          //clear extra space
             true);         //avoid reallocating
+
+        //enough buffers to cover the longest gap between reads, whatever the block size.
+        //only picks how many of the fixed slots are used.
+        auto samplesBetweenReads = sampleRate * maxSecondsBetweenReads;
+        auto capacity = (int)std::ceil(samplesBetweenReads / juce::jmax(1, bufferSize)) + 1;
+        audioBufferFifo.setCapacity(juce::jlimit(2, maxBuffers, capacity));
         audioBufferFifo.prepare(1, bufferSize);
         fifoIndex = 0;
         prepared.set(true);
     }
     //==============================================================================
-    int getNumCompleteBuffersAvailable() const { return audioBufferFifo.getNumAvailableForReading(); }
+    int getNumCompleteBuffersAvailable() const { return prepared.get() ? audioBufferFifo.getNumAvailableForReading() : 0; }
     bool isPrepared() const { return prepared.get(); }
     int getSize() const { return size.get(); }
+    Channel getChannel() const { return channelToUse; }
+    //==============================================================================
+    //the flag is raised before 'prepared' is checked, and prepare() lowers 'prepared' before checking the flag,
+    //so one of them always sees the other.
+    bool getAudioBuffer(BlockType& buf)
+    {
+        readInProgress.set(true);
+        auto pulled = prepared.get() && audioBufferFifo.pull(buf);
+        readInProgress.set(false);
+        return pulled;
+    }
     //==============================================================================
-    bool getAudioBuffer(BlockType& buf) { return audioBufferFifo.pull(buf); }
+    //audio thread only: drops the samples collected so far for the next buffer.
+    void discardPartialBuffer() { fifoIndex = 0; }
+
+    //the editor reads at least this often while it's showing. if it falls further behind, new buffers are dropped.
+    static constexpr double maxSecondsBetweenReads = 0.1;
+    //covers that gap at 192 kHz down to 64 sample blocks. smaller blocks drop buffers sooner.
+    static constexpr int maxBuffers = 512;
 private:
     Channel channelToUse;
     int fifoIndex = 0;
-    Fifo<BlockType> audioBufferFifo;
+    Fifo<BlockType> audioBufferFifo{ maxBuffers };
     BlockType bufferToFill;
     juce::Atomic<bool> prepared = false;
+    juce::Atomic<bool> readInProgress = false;
     juce::Atomic<int> size = 0;
 
     void pushNextSampleIntoFifo(float sample)
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    StateFormat.cpp
+    Created: 20 Oct 2026 1:32:26am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "StateFormat.h"
+
+namespace StateFormat
+{
+namespace
+{
+    constexpr char magic[] = { 'S', 'M', 'B', 'C' };
+    constexpr size_t headerSize = sizeof(magic) + 2;
+
+    /*
+     what's written, and what an unchanged parameter is compared against on restore. going
+     through getValue() both times means a value that round-trips compares exactly equal.
+     */
+    float getPlainValue(const juce::RangedAudioParameter& param)
+    {
+        return param.convertFrom0to1(param.getValue());
+    }
+}
+
+void write(const Params::Registry& registry, juce::MemoryBlock& destData)
+{
+    static_assert(Params::NumParams < 256, "the count is a single byte");
+
+    destData.setSize(headerSize + Params::NumParams * sizeof(float));
+    auto* bytes = static_cast<char*>(destData.getData());
+
+    std::memcpy(bytes, magic, sizeof(magic));
+    bytes[sizeof(magic)] = (char)currentVersion;
+    bytes[sizeof(magic) + 1] = (char)Params::NumParams;
+
+    auto* values = bytes + headerSize;
+    for (int i = 0; i < Params::NumParams; ++i)
+    {
+        auto* param = registry.get<juce::RangedAudioParameter>(static_cast<Params::Names>(i));
+        auto value = getPlainValue(*param);
+
+        juce::uint32 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        bits = juce::ByteOrder::swapIfBigEndian(bits);
+        std::memcpy(values + i * sizeof(float), &bits, sizeof(bits));
+    }
+}
+
+bool isBinaryState(const void* data, size_t sizeInBytes)
+{
+    return data != nullptr && sizeInBytes >= headerSize && std::memcmp(data, magic, sizeof(magic)) == 0;
+}
+
+bool restore(const Params::Registry& registry, const void* data, size_t sizeInBytes, int* numChanged)
+{
+    if (numChanged != nullptr)
+        *numChanged = 0;
+
+    if (!isBinaryState(data, sizeInBytes))
+        return false;
+
+    auto* bytes = static_cast<const char*>(data);
+    auto version = (int)(juce::uint8)bytes[sizeof(magic)];
+    auto count = (int)(juce::uint8)bytes[sizeof(magic) + 1];
+
+    if (version < 1 || version > currentVersion || sizeInBytes < headerSize + (size_t)count * sizeof(float))
+        return false;
+
+    auto* values = bytes + headerSize;
+    int changed = 0;
+
+    //a newer layout's extra values are ignored, an older layout's missing ones go back to their defaults.
+    for (int i = 0; i < Params::NumParams; ++i)
+    {
+        auto* param = registry.get<juce::RangedAudioParameter>(static_cast<Params::Names>(i));
+        float newValue;
+
+        if (i < count)
+        {
+            juce::uint32 bits;
+            std::memcpy(&bits, values + i * sizeof(float), sizeof(bits));
+            bits = juce::ByteOrder::swapIfBigEndian(bits);
+            std::memcpy(&newValue, &bits, sizeof(newValue));
+
+            if (!std::isfinite(newValue))
+                continue;
+        }
+        else
+        {
+            newValue = param->convertFrom0to1(param->getDefaultValue());
+        }
+
+        if (newValue == getPlainValue(*param))
+            continue;
+
+        param->setValueNotifyingHost(param->convertTo0to1(newValue));
+        ++changed;
+    }
+
+    if (numChanged != nullptr)
+        *numChanged = changed;
+
+    return true;
+}
+}
@@ -0,0 +1,41 @@
+/*
+  ==============================================================================
+
+    StateFormat.h
+    Created: 20 Oct 2026 1:32:26am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "Params.h"
+
+/*
+ the plugin's saved state: a small binary blob instead of the whole apvts ValueTree.
+
+   4 bytes  magic "SMBC"
+   1 byte   version (bumped only when the encoding changes)
+   1 byte   number of values that follow
+   4 bytes  per parameter: its value in its own units, as a little-endian float, in Params::Names order
+
+ Names is append-only, so a state saved before a parameter existed still lines up;
+ parameters it doesn't have are set to their defaults.
+ */
+namespace StateFormat
+{
+    constexpr int currentVersion = 1;
+
+    void write(const Params::Registry& registry, juce::MemoryBlock& destData);
+
+    //true if 'data' starts like a blob from write(). anything else is treated as the old ValueTree state.
+    bool isBinaryState(const void* data, size_t sizeInBytes);
+
+    /*
+     sets only the parameters whose value differs from the blob's, so restoring the state
+     the plugin already has notifies nobody. returns false, changing nothing, if the blob
+     is malformed or from a newer version. 'numChanged' is how many were set.
+     */
+    bool restore(const Params::Registry& registry, const void* data, size_t sizeInBytes, int* numChanged = nullptr);
+}
@@ -0,0 +1,219 @@
+/*
+  ==============================================================================
+
+    TransferFunctionMeasurement.cpp
+    Created: 20 Oct 2026 12:47:15am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "TransferFunctionMeasurement.h"
+#include <complex>
+
+void TransferFunctionMeasurement::prepare(double newSampleRate)
+{
+    const juce::ScopedLock sl(recordingLock);
+
+    //whoever started it is told it won't finish.
+    state.store(state.load() == Idle ? Idle : Cancelled);
+    sampleRate = newSampleRate;
+    sweepEndFrequency = juce::jmin(endFrequency, (float)(0.45 * sampleRate));
+
+    //exponential sweep (Farina): equal time per octave, so the low end gets as much energy as the top.
+    const auto sweepLength = (int)(sweepSeconds * sampleRate);
+    const auto k = std::log((double)sweepEndFrequency / startFrequency);
+    const auto amplitude = juce::Decibels::decibelsToGain(sweepLeveldB);
+
+    sweep.resize((size_t)sweepLength);
+    for (int i = 0; i < sweepLength; ++i)
+    {
+        auto t = i / sampleRate;
+        auto phase = juce::MathConstants<double>::twoPi * startFrequency * sweepSeconds / k * (std::exp(t / sweepSeconds * k) - 1.0);
+        sweep[(size_t)i] = amplitude * (float)std::sin(phase);
+    }
+
+    //short fades so the ends don't click.
+    const auto fadeLength = juce::jmin(sweepLength / 2, (int)(0.005 * sampleRate));
+    for (int i = 0; i < fadeLength; ++i)
+    {
+        auto fade = (float)i / (float)fadeLength;
+        sweep[(size_t)i] *= fade;
+        sweep[(size_t)(sweepLength - 1 - i)] *= fade;
+    }
+
+    captured.assign((size_t)(sweepLength + (int)(tailSeconds * sampleRate)), 0.f);
+    position = 0;
+}
+
+void TransferFunctionMeasurement::start()
+{
+    //prepare() hasn't been called yet: nothing to play.
+    if (sweep.empty())
+        return;
+
+    state.store(Armed, std::memory_order_release);
+}
+
+void TransferFunctionMeasurement::cancel()
+{
+    state.store(Idle, std::memory_order_release);
+}
+
+bool TransferFunctionMeasurement::isRunning() const
+{
+    auto current = state.load(std::memory_order_acquire);
+    return current == Armed || current == Running;
+}
+
+bool TransferFunctionMeasurement::replaceInput(juce::AudioBuffer<float>& buffer)
+{
+    auto current = state.load(std::memory_order_acquire);
+    if (current == Armed)
+    {
+        position = 0;
+        state.store(Running, std::memory_order_relaxed);
+    }
+    else if (current != Running)
+    {
+        return false;
+    }
+
+    const auto numSamples = buffer.getNumSamples();
+    const auto sweepLength = (int)sweep.size();
+
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        auto* samples = buffer.getWritePointer(ch);
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto index = position + i;
+            samples[i] = index < sweepLength ? sweep[(size_t)index] : 0.f;
+        }
+    }
+
+    return true;
+}
+
+void TransferFunctionMeasurement::captureOutput(const juce::AudioBuffer<float>& buffer)
+{
+    if (state.load(std::memory_order_relaxed) != Running)
+        return;
+
+    const auto numChannels = buffer.getNumChannels();
+    const auto numSamples = juce::jmin(buffer.getNumSamples(), (int)captured.size() - position);
+    const auto scale = 1.f / (float)juce::jmax(1, numChannels);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        auto sum = 0.f;
+        for (int ch = 0; ch < numChannels; ++ch)
+            sum += buffer.getSample(ch, i);
+
+        captured[(size_t)(position + i)] = sum * scale;
+    }
+
+    position += numSamples;
+
+    //start() or cancel() from another thread wins over finishing.
+    if (position >= (int)captured.size())
+    {
+        int expected = Running;
+        state.compare_exchange_strong(expected, Complete, std::memory_order_release, std::memory_order_relaxed);
+    }
+}
+
+TransferFunctionMeasurement::Recording TransferFunctionMeasurement::getRecording() const
+{
+    const juce::ScopedLock sl(recordingLock);
+
+    Recording recording;
+    if (!isComplete())
+        return recording;
+
+    recording.sampleRate = sampleRate;
+    recording.sweepEndFrequency = sweepEndFrequency;
+    recording.sweep = sweep;
+    recording.captured = captured;
+    return recording;
+}
+
+TransferFunctionMeasurement::Response TransferFunctionMeasurement::computeResponse(const Recording& recording, int numPoints)
+{
+    Response response;
+    if (recording.isEmpty() || numPoints < 2)
+        return response;
+
+    const auto& sweep = recording.sweep;
+    const auto& captured = recording.captured;
+    const auto sampleRate = recording.sampleRate;
+    const auto sweepEndFrequency = recording.sweepEndFrequency;
+
+    using Complex = std::complex<float>;
+    const auto order = juce::jmax(1, (int)std::ceil(std::log2((double)captured.size())));
+    const auto fftSize = 1 << order;
+    juce::dsp::FFT fft(order);
+
+    auto transform = [&fft, fftSize](const std::vector<float>& samples)
+    {
+        std::vector<Complex> input((size_t)fftSize), output((size_t)fftSize);
+        for (size_t i = 0; i < samples.size(); ++i)
+            input[i] = samples[i];
+
+        fft.perform(input.data(), output.data(), false);
+        return output;
+    };
+
+    auto x = transform(sweep);
+    auto y = transform(captured);
+
+    //regularised division: outside the sweep |X| is tiny and Y/X would just be amplified noise.
+    auto maxPower = 0.f;
+    for (const auto& bin : x)
+        maxPower = juce::jmax(maxPower, std::norm(bin));
+
+    const auto epsilon = maxPower * 1.0e-8f;
+    std::vector<Complex> h((size_t)fftSize);
+    for (size_t k = 0; k < h.size(); ++k)
+        h[k] = y[k] * std::conj(x[k]) / (std::norm(x[k]) + epsilon);
+
+    /*
+     back to the impulse response, keeping only the causal part the tail had time to capture:
+     an exponential sweep puts any distortion products before t = 0, i.e. at the end of the buffer.
+     */
+    std::vector<Complex> impulse((size_t)fftSize);
+    fft.perform(h.data(), impulse.data(), true);
+
+    const auto keep = juce::jmin(fftSize, (int)(tailSeconds * sampleRate));
+    const auto fadeStart = keep * 3 / 4;
+    for (int i = 0; i < fftSize; ++i)
+    {
+        if (i >= keep)
+            impulse[(size_t)i] = 0.f;
+        else if (i >= fadeStart)
+            impulse[(size_t)i] *= 0.5f * (1.f + std::cos(juce::MathConstants<float>::pi * (float)(i - fadeStart) / (float)(keep - fadeStart)));
+    }
+
+    fft.perform(impulse.data(), h.data(), false);
+
+    const auto binWidth = sampleRate / fftSize;
+    const auto maxBin = fftSize / 2 - 1;
+
+    for (int point = 0; point < numPoints; ++point)
+    {
+        auto frequency = juce::mapToLog10((float)point / (float)(numPoints - 1), startFrequency, sweepEndFrequency);
+        auto bin = juce::jlimit(1, maxBin - 1, juce::roundToInt(frequency / binWidth));
+        const auto& value = h[(size_t)bin];
+
+        //the phase change between neighbouring bins, without having to unwrap anything.
+        auto phaseStep = std::arg(h[(size_t)bin + 1] * std::conj(h[(size_t)bin - 1]));
+        auto groupDelaySeconds = -phaseStep / (juce::MathConstants<double>::twoPi * 2.0 * binWidth);
+
+        response.frequencies.push_back(frequency);
+        response.magnitudedB.push_back(juce::Decibels::gainToDecibels(std::abs(value), -200.f));
+        response.phaseDegrees.push_back(juce::radiansToDegrees(std::arg(value)));
+        response.groupDelayMs.push_back((float)(groupDelaySeconds * 1000.0));
+    }
+
+    return response;
+}
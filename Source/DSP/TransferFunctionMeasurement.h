@@ -0,0 +1,92 @@
+/*
+  ==============================================================================
+
+    TransferFunctionMeasurement.h
+    Created: 20 Oct 2026 12:47:15am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <vector>
+
+/*
+ measures what processBlock() does to a signal: an exponential sine sweep replaces the
+ input, the output is captured, and the two are deconvolved into the transfer function.
+
+ the sweep and capture buffers are allocated in prepare(). while a measurement runs the
+ audio thread only copies samples; the FFTs happen in computeResponse(), off the audio thread.
+ the processor silences its output while a measurement is armed or running, so the sweep
+ never reaches the monitors or a bounce.
+ */
+struct TransferFunctionMeasurement
+{
+    static constexpr float startFrequency = 20.f;
+    static constexpr float endFrequency = 20000.f;    //or 0.45 * the sample rate, if lower
+    static constexpr double sweepSeconds = 1.0;
+    static constexpr double tailSeconds = 0.25;       //silence after the sweep, for the response to ring out
+    static constexpr float sweepLeveldB = -12.f;
+
+    //with the audio stopped, i.e. from prepareToPlay(). a measurement in progress, or finished
+    //but not yet read, is dropped and isCancelled() turns true.
+    void prepare(double sampleRate);
+
+    //any thread. the next block after this starts the sweep.
+    void start();
+    void cancel();
+
+    bool isRunning() const;
+    bool isComplete() const { return state.load(std::memory_order_acquire) == Complete; }
+    bool isCancelled() const { return state.load(std::memory_order_acquire) == Cancelled; }
+
+    //audio thread: while measuring, overwrites every channel of 'buffer' with the sweep. returns true if it did.
+    bool replaceInput(juce::AudioBuffer<float>& buffer);
+
+    //audio thread, after replaceInput() returned true for the same block: records the mean of the channels.
+    void captureOutput(const juce::AudioBuffer<float>& buffer);
+
+    struct Response
+    {
+        std::vector<float> frequencies;     //log spaced
+        std::vector<float> magnitudedB;
+        std::vector<float> phaseDegrees;    //wrapped to +-180
+        std::vector<float> groupDelayMs;
+
+        bool isEmpty() const { return frequencies.empty(); }
+    };
+
+    //a finished sweep and what came back, copied out so the deconvolution can run on any thread.
+    struct Recording
+    {
+        double sampleRate = 0.0;
+        float sweepEndFrequency = endFrequency;
+        std::vector<float> sweep, captured;
+
+        bool isEmpty() const { return captured.empty(); }
+    };
+
+    //from any thread but the audio thread. empty unless isComplete().
+    Recording getRecording() const;
+
+    //'numPoints' from startFrequency to the end of the sweep.
+    static Response computeResponse(const Recording& recording, int numPoints = 512);
+    Response computeResponse(int numPoints = 512) const { return computeResponse(getRecording(), numPoints); }
+
+    double getSampleRate() const { return sampleRate; }
+private:
+    enum State { Idle, Armed, Running, Complete, Cancelled };
+    std::atomic<int> state{ Idle };
+
+    //held by prepare() and getRecording(), never by the audio thread.
+    juce::CriticalSection recordingLock;
+
+    double sampleRate = 0.0;
+    float sweepEndFrequency = endFrequency;
+    std::vector<float> sweep, captured;
+
+    //audio thread only while Running.
+    int position = 0;
+};
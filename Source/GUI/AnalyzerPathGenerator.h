@@ -13,11 +13,17 @@
 #include "../PluginProcessor.h"
 #include "../DSP/Fifo.h"
 
+enum class ColumnReduction
+{
+    Peak,
+    RMS
+};
+
 template<typename PathType>
 struct AnalyzerPathGenerator
 {
     /*
-     converts 'renderData[]' into a juce::Path
+     converts 'renderData[]' into a juce::Path with one vertex per pixel column.
      */
     void generatePath(const std::vector<float>& renderData,
         juce::Rectangle<float> fftBounds,
@@ -25,14 +31,96 @@ struct AnalyzerPathGenerator
         float binWidth,
         float negativeInfinity)
     {
-        auto top = fftBounds.getY();
-        auto bottom = fftBounds.getBottom();
-        auto width = fftBounds.getWidth();
+        int numBins = (int)fftSize / 2;
+        int numColumns = juce::jmax(1, (int)std::floor(fftBounds.getWidth()));
+
+        updateColumnMapping(numColumns, numBins, binWidth);
+        emitPath(renderData, numColumns, numBins, fftBounds, negativeInfinity);
+    }
+
+    /*
+     same as generatePath(), for data that is already spaced evenly in log frequency
+     between MIN_FREQUENCY and MAX_FREQUENCY (see MultiResolutionFFTDataGenerator).
+     */
+    void generateLogPath(const std::vector<float>& renderData,
+        juce::Rectangle<float> fftBounds,
+        float negativeInfinity)
+    {
+        int numPoints = (int)renderData.size();
+        int numColumns = juce::jmax(1, (int)std::floor(fftBounds.getWidth()));
+
+        updateLogColumnMapping(numColumns, numPoints);
+        emitPath(renderData, numColumns, numPoints, fftBounds, negativeInfinity);
+    }
 
+    /*
+     one dB value per pixel column, reduced with the same cached table generatePath() uses.
+     columns above nyquist get NEGATIVE_INFINITY.
+     */
+    void generateColumnLevels(const std::vector<float>& renderData,
+        int numColumns,
+        int fftSize,
+        float binWidth,
+        std::vector<float>& levels)
+    {
         int numBins = (int)fftSize / 2;
+        updateColumnMapping(numColumns, numBins, binWidth);
+        reduceColumns(renderData, numColumns, numBins, levels);
+    }
+
+    void generateLogColumnLevels(const std::vector<float>& renderData,
+        int numColumns,
+        std::vector<float>& levels)
+    {
+        int numPoints = (int)renderData.size();
+        updateLogColumnMapping(numColumns, numPoints);
+        reduceColumns(renderData, numColumns, numPoints, levels);
+    }
+
+    void setColumnReduction(ColumnReduction newReduction) { reduction = newReduction; }
+
+    int getNumPathsAvailable() const
+    {
+        return pathFifo.getNumAvailableForReading();
+    }
+
+    bool getPath(PathType& path)
+    {
+        return pathFifo.pull(path);
+    }
+private:
+    //only the newest path is ever drawn.
+    Fifo<PathType> pathFifo{ 1 };
+
+    /*
+     the range of bins that land in a pixel column.
+     if the range is empty (low frequencies, less than one bin per column)
+     the column is interpolated at 'binPosition' instead.
+     */
+    struct ColumnBins
+    {
+        int firstBin = 0;   // inclusive
+        int lastBin = 0;    // exclusive
+        float binPosition = 0.f;
+        bool isBelowNyquist = false;
+    };
+
+    std::vector<ColumnBins> columns;
+    int mappedColumns = 0;
+    int mappedBins = 0;
+    float mappedBinWidth = 0.f; //0 means the table was built for log spaced data
+
+    void emitPath(const std::vector<float>& renderData,
+        int numColumns,
+        int numBins,
+        juce::Rectangle<float> fftBounds,
+        float negativeInfinity)
+    {
+        auto top = fftBounds.getY();
+        auto bottom = fftBounds.getBottom();
 
         PathType p;
-        p.preallocateSpace(3 * (int)fftBounds.getWidth());
+        p.preallocateSpace(3 * numColumns);
 
         auto map = [bottom, top, negativeInfinity](float v)
             {
@@ -41,43 +129,128 @@ struct AnalyzerPathGenerator
                     bottom, top);
             };
 
-        auto y = map(renderData[0]);
+        bool pathStarted = false;
+
+        for (int x = 0; x < numColumns; ++x)
+        {
+            const auto& column = columns[x];
+            if (!column.isBelowNyquist)
+                break;
+
+            auto y = map(reduceColumn(renderData, column, numBins));
+
+            if (std::isnan(y) || std::isinf(y))
+                y = bottom;
 
-        //        jassert( !std::isnan(y) && !std::isinf(y) );
-        if (std::isnan(y) || std::isinf(y))
-            y = bottom;
+            if (pathStarted)
+            {
+                p.lineTo(x, y);
+            }
+            else
+            {
+                p.startNewSubPath(x, y);
+                pathStarted = true;
+            }
+        }
 
-        p.startNewSubPath(0, y);
+        pathFifo.pushLatest(p);
+    }
 
-        const int pathResolution = 2; //you can draw line-to's every 'pathResolution' pixels.
+    void reduceColumns(const std::vector<float>& renderData, int numColumns, int numBins, std::vector<float>& levels) const
+    {
+        levels.resize((size_t)numColumns);
 
-        for (int binNum = 1; binNum < numBins; binNum += pathResolution)
+        for (int x = 0; x < numColumns; ++x)
         {
-            y = map(renderData[binNum]);
+            const auto& column = columns[x];
+            levels[x] = column.isBelowNyquist ? reduceColumn(renderData, column, numBins) : NEGATIVE_INFINITY;
+        }
+    }
+
+    ColumnReduction reduction = ColumnReduction::Peak;
 
-            //            jassert( !std::isnan(y) && !std::isinf(y) );
+    /*
+     rebuilds the column table when the width, fft size or sample rate changes.
+     */
+    void updateColumnMapping(int numColumns, int numBins, float binWidth)
+    {
+        if (numColumns == mappedColumns && numBins == mappedBins && binWidth == mappedBinWidth)
+            return;
 
-            if (!std::isnan(y) && !std::isinf(y))
+        mappedColumns = numColumns;
+        mappedBins = numBins;
+        mappedBinWidth = binWidth;
+
+        columns.resize(numColumns);
+
+        auto columnToFreq = [numColumns](float x)
             {
-                auto binFreq = binNum * binWidth;
-                auto normalizedBinX = juce::mapFromLog10(binFreq, MIN_FREQUENCY , MAX_FREQUENCY);
-                int binX = std::floor(normalizedBinX * width);
-                p.lineTo(binX, y);
-            }
-        }
+                return juce::mapToLog10(x / (float)numColumns, MIN_FREQUENCY, MAX_FREQUENCY);
+            };
 
-        pathFifo.push(p);
+        const auto lastInterpolatableBin = (float)(numBins - 1);
+
+        for (int x = 0; x < numColumns; ++x)
+        {
+            auto startBin = columnToFreq((float)x) / binWidth;
+            auto endBin = columnToFreq((float)(x + 1)) / binWidth;
+
+            auto& column = columns[x];
+            column.firstBin = juce::jmax(1, (int)std::ceil(startBin));
+            column.lastBin = juce::jmin(numBins, (int)std::ceil(endBin));
+            column.binPosition = juce::jlimit(1.f, lastInterpolatableBin, columnToFreq((float)x + 0.5f) / binWidth);
+            column.isBelowNyquist = startBin < lastInterpolatableBin;
+        }
     }
 
-    int getNumPathsAvailable() const
+    void updateLogColumnMapping(int numColumns, int numPoints)
     {
-        return pathFifo.getNumAvailableForReading();
+        if (numColumns == mappedColumns && numPoints == mappedBins && mappedBinWidth == 0.f)
+            return;
+
+        mappedColumns = numColumns;
+        mappedBins = numPoints;
+        mappedBinWidth = 0.f;
+
+        columns.resize(numColumns);
+
+        const auto pointsPerColumn = (float)(numPoints - 1) / (float)numColumns;
+        const auto lastInterpolatablePoint = (float)(numPoints - 1);
+
+        for (int x = 0; x < numColumns; ++x)
+        {
+            auto& column = columns[x];
+            column.firstBin = (int)std::ceil((float)x * pointsPerColumn);
+            column.lastBin = juce::jmin(numPoints, (int)std::ceil((float)(x + 1) * pointsPerColumn));
+            column.binPosition = juce::jlimit(0.f, lastInterpolatablePoint, ((float)x + 0.5f) * pointsPerColumn);
+            column.isBelowNyquist = true;
+        }
     }
 
-    bool getPath(PathType& path)
+    float reduceColumn(const std::vector<float>& renderData, const ColumnBins& column, int numBins) const
     {
-        return pathFifo.pull(path);
+        if (column.lastBin <= column.firstBin)
+        {
+            auto index = (int)column.binPosition;
+            auto next = juce::jmin(index + 1, numBins - 1);
+            auto frac = column.binPosition - (float)index;
+            return renderData[index] + frac * (renderData[next] - renderData[index]);
+        }
+
+        if (reduction == ColumnReduction::Peak)
+        {
+            auto peak = renderData[column.firstBin];
+            for (int bin = column.firstBin + 1; bin < column.lastBin; ++bin)
+                peak = juce::jmax(peak, renderData[bin]);
+
+            return peak;
+        }
+
+        //RMS is taken over power, not over the dB values.
+        auto sum = 0.f;
+        for (int bin = column.firstBin; bin < column.lastBin; ++bin)
+            sum += std::pow(10.f, renderData[bin] * 0.1f);
+
+        return 10.f * std::log10(sum / (float)(column.lastBin - column.firstBin));
     }
-private:
-    Fifo<PathType> pathFifo;
 };
@@ -72,6 +72,7 @@ CompressorBandControls::CompressorBandControls(juce::AudioProcessorValueTreeStat
 
     lowBand.setToggleState(true, juce::NotificationType::dontSendNotification);
 
+    createAttachments();
     updateAttachments();
     updateSliderEnablements();
     updateBandSelectButtonStates();
@@ -90,6 +91,20 @@ CompressorBandControls::~CompressorBandControls()
     bypassButton.removeListener(this);
     soloButton.removeListener(this);
     muteButton.removeListener(this);
+
+    //the buttons are declared after the attachments, so they'd be gone before the attachments let go of them.
+    bypassButtonAttachment.reset();
+    soloButtonAttachment.reset();
+    muteButtonAttachment.reset();
+}
+
+bool CompressorBandControls::updateFrame()
+{
+    bool changed = false;
+    for (auto* attachment : { attackSliderAttachment.get(), releaseSliderAttachment.get(), thresholdSliderAttachment.get(), ratioSliderAttachment.get() })
+        changed = attachment->updateFrame() || changed;
+
+    return changed;
 }
 
 void CompressorBandControls::resized()
@@ -202,42 +217,28 @@ void CompressorBandControls::resetActiveBandColours()
 
 void CompressorBandControls::updateBandSelectButtonStates()
 {
-    using namespace Params;
-
-    std::vector<std::array<Names, 3>> paramsToCheck
-    {
-        {Names::Solo_Low_Band,  Names::Mute_Low_Band,  Names::Bypass_Low_Band },
-        {Names::Solo_Mid_Band,  Names::Mute_Mid_Band,  Names::Bypass_Mid_Band },
-        {Names::Solo_High_Band, Names::Mute_High_Band, Names::Bypass_High_Band},
-    };
-
-    const auto& params = GetParams();
-
-    auto paramHelper = [&params, this](const auto& name)
+    auto isOn = [](const juce::RangedAudioParameter* param)
         {
-            return dynamic_cast<juce::AudioParameterBool*>(&getParam(apvts, params, name));
+            return dynamic_cast<const juce::AudioParameterBool*>(param)->get();
         };
 
-    for (size_t i = 0; i < paramsToCheck.size(); ++i)
+    for (size_t i = 0; i < bandParams.size(); ++i)
     {
-        auto& list = paramsToCheck[i];
+        const auto& params = bandParams[i];
 
         auto* bandButton = (i == 0) ? &lowBand :
                            (i == 1) ? &midBand :
                                       &highBand;
 
-        if (auto* solo = paramHelper(list[0]);
-            solo->get())
+        if (isOn(params[Solo]))
         {
             refreshBandButtonColours(*bandButton, soloButton);
         }
-        else if (auto* mute = paramHelper(list[1]);
-            mute->get())
+        else if (isOn(params[Mute]))
         {
             refreshBandButtonColours(*bandButton, muteButton);
         }
-        else if (auto* bypass = paramHelper(list[2]);
-            bypass->get())
+        else if (isOn(params[Bypass]))
         {
             refreshBandButtonColours(*bandButton, bypassButton);
         }
@@ -274,137 +275,92 @@ void CompressorBandControls::updateSoloMuteBypassToggleStates(juce::Button& clic
 
 }
 
-void CompressorBandControls::updateAttachments()
+void CompressorBandControls::createAttachments()
 {
-    enum BandType
+    using namespace Params;
+
+    const std::array<std::array<Names, NumBandControls>, 3> bandParamNames
+    { {
+        { Names::Attack_Low_band,  Names::Release_Low_Band,  Names::Threshold_Low_Band,  Names::Ratio_Low_Band,  Names::Mute_Low_Band,  Names::Solo_Low_Band,  Names::Bypass_Low_Band },
+        { Names::Attack_Mid_band,  Names::Release_Mid_Band,  Names::Threshold_Mid_Band,  Names::Ratio_Mid_Band,  Names::Mute_Mid_Band,  Names::Solo_Mid_Band,  Names::Bypass_Mid_Band },
+        { Names::Attack_High_band, Names::Release_High_Band, Names::Threshold_High_Band, Names::Ratio_High_Band, Names::Mute_High_Band, Names::Solo_High_Band, Names::Bypass_High_Band },
+    } };
+
+    const auto& params = GetParams();
+
+    for (size_t band = 0; band < bandParams.size(); ++band)
     {
-        Low,
-        Mid,
-        High
-    };
+        for (int control = 0; control < NumBandControls; ++control)
+            bandParams[band][control] = &getParam(apvts, params, bandParamNames[band][control]);
+    }
 
-    BandType bandType = [this]()
+    auto paramsFor = [this](BandControl control)
+        {
+            std::vector<juce::RangedAudioParameter*> result;
+            for (const auto& band : bandParams)
+                result.push_back(band[control]);
+
+            return result;
+        };
+
+    attackSliderAttachment = std::make_unique<SwitchableSliderAttachment>(attackSlider, paramsFor(Attack));
+    releaseSliderAttachment = std::make_unique<SwitchableSliderAttachment>(releaseSlider, paramsFor(Release));
+    thresholdSliderAttachment = std::make_unique<SwitchableSliderAttachment>(thresholdSlider, paramsFor(Threshold));
+    ratioSliderAttachment = std::make_unique<SwitchableSliderAttachment>(ratioSlider, paramsFor(Ratio));
+    bypassButtonAttachment = std::make_unique<SwitchableButtonAttachment>(bypassButton, paramsFor(Bypass));
+    soloButtonAttachment = std::make_unique<SwitchableButtonAttachment>(soloButton, paramsFor(Solo));
+    muteButtonAttachment = std::make_unique<SwitchableButtonAttachment>(muteButton, paramsFor(Mute));
+}
+
+void CompressorBandControls::updateAttachments()
+{
+    int band = [this]()
         {
             if (lowBand.getToggleState())
-                return BandType::Low;
+                return 0;
             if (midBand.getToggleState())
-                return BandType::Mid;
+                return 1;
 
-            return BandType::High;
+            return 2;
         }();
 
-        using namespace Params;
-        std::vector<Names> names;
+    activeBand = (band == 0) ? &lowBand :
+                 (band == 1) ? &midBand :
+                               &highBand;
 
-        switch (bandType)
-        {
-            case Low:
-            {
-                names = std::vector<Names>
-                {
-                    Names::Attack_Low_band,
-                    Names::Release_Low_Band,
-                    Names::Threshold_Low_Band,
-                    Names::Ratio_Low_Band,
-                    Names::Mute_Low_Band,
-                    Names::Solo_Low_Band,
-                    Names::Bypass_Low_Band
-                };
-                activeBand = &lowBand;
-                break;
-            }
-            case Mid:
-            {
-                names = std::vector<Names>
-                {
-                    Names::Attack_Mid_band,
-                    Names::Release_Mid_Band,
-                    Names::Threshold_Mid_Band,
-                    Names::Ratio_Mid_Band,
-                    Names::Mute_Mid_Band,
-                    Names::Solo_Mid_Band,
-                    Names::Bypass_Mid_Band
-                };
-                activeBand = &midBand;
-                break;
-            }
-            case High:
-            {
-                names = std::vector<Names>
-                {
-                    Names::Attack_High_band,
-                    Names::Release_High_Band,
-                    Names::Threshold_High_Band,
-                    Names::Ratio_High_Band,
-                    Names::Mute_High_Band,
-                    Names::Solo_High_Band,
-                    Names::Bypass_High_Band
-                };
-                activeBand = &highBand;
-                break;
-            }
-        }
+    DBG("Active Band: " << activeBand->getName());
 
-        DBG("Active Band: " << activeBand->getName());
+    const auto& params = bandParams[band];
 
-        enum Pos
-        {
-            Attack,
-            Release,
-            Threshold,
-            Ratio,
-            Mute,
-            Solo,
-            Bypass
-        };
+    addLabelPairs(attackSlider.labels, *params[Attack], "ms");
+    attackSlider.changeParam(params[Attack]);
 
-        const auto& params = GetParams();
+    addLabelPairs(releaseSlider.labels, *params[Release], "ms");
+    releaseSlider.changeParam(params[Release]);
 
-        auto getParamHelper = [&params, &apvts = this -> apvts, &names](const auto& pos) -> auto&
-            {
-                return getParam(apvts, params, names.at(pos));
-            };
-
-
-        attackSliderAttachment.reset();
-        releaseSliderAttachment.reset();
-        thresholdSliderAttachment.reset();
-        ratioSliderAttachment.reset();
-        bypassButtonAttachment.reset();
-        soloButtonAttachment.reset();
-        muteButtonAttachment.reset();
-
-        auto& attackParam = getParamHelper(Pos::Attack);
-        addLabelPairs(attackSlider.labels, attackParam, "ms");
-        attackSlider.changeParam(&attackParam);
-
-        auto& releaseParam = getParamHelper(Pos::Release);
-        addLabelPairs(releaseSlider.labels, releaseParam, "ms");
-        releaseSlider.changeParam(&releaseParam);
-
-        auto& threshParam = getParamHelper(Pos::Threshold);
-        addLabelPairs(thresholdSlider.labels, threshParam, "dB");
-        thresholdSlider.changeParam(&threshParam);
-
-        auto& ratioParamRap = getParamHelper(Pos::Ratio);
-        ratioSlider.labels.clear();
-        ratioSlider.labels.add({ 0.f, "1:1" });
-        auto ratioParam = dynamic_cast<juce::AudioParameterChoice*>(&ratioParamRap);
-        ratioSlider.labels.add({ 1.0f,
-            juce::String(ratioParam->choices.getReference(ratioParam->choices.size() - 1).getIntValue()) + ":1" });
-        ratioSlider.changeParam(ratioParam);
-
-        auto makeAttachmentHelper = [&params, &apvts = this->apvts](auto& attachment, const auto& name, auto& slider)
-            {
-                makeAttachment(attachment, apvts, params, name, slider);
-            };
+    addLabelPairs(thresholdSlider.labels, *params[Threshold], "dB");
+    thresholdSlider.changeParam(params[Threshold]);
+
+    ratioSlider.labels.clear();
+    ratioSlider.labels.add({ 0.f, "1:1" });
+    auto ratioParam = dynamic_cast<juce::AudioParameterChoice*>(params[Ratio]);
+    ratioSlider.labels.add({ 1.0f,
+        juce::String(ratioParam->choices.getReference(ratioParam->choices.size() - 1).getIntValue()) + ":1" });
+    ratioSlider.changeParam(ratioParam);
 
-        makeAttachmentHelper(attackSliderAttachment, names[Pos::Attack], attackSlider);
-        makeAttachmentHelper(releaseSliderAttachment, names[Pos::Release], releaseSlider);
-        makeAttachmentHelper(thresholdSliderAttachment, names[Pos::Threshold], thresholdSlider);
-        makeAttachmentHelper(ratioSliderAttachment, names[Pos::Ratio], ratioSlider);
-        makeAttachmentHelper(bypassButtonAttachment, names[Pos::Bypass], bypassButton);
-        makeAttachmentHelper(soloButtonAttachment, names[Pos::Solo], soloButton);
-        makeAttachmentHelper(muteButtonAttachment, names[Pos::Mute], muteButton);;
+    attackSliderAttachment->setActiveIndex(band);
+    releaseSliderAttachment->setActiveIndex(band);
+    thresholdSliderAttachment->setActiveIndex(band);
+    ratioSliderAttachment->setActiveIndex(band);
 
+    /*
+     silently: buttonClicked() would turn the other two buttons off, and whichever of them
+     hadn't switched yet would write that into the previous band's parameters.
+     the new band's parameters are already consistent, only the UI needs to follow.
+     */
+    bypassButtonAttachment->setActiveIndex(band, juce::dontSendNotification);
+    soloButtonAttachment->setActiveIndex(band, juce::dontSendNotification);
+    muteButtonAttachment->setActiveIndex(band, juce::dontSendNotification);
+
+    updateSliderEnablements();
 }
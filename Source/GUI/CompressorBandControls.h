@@ -11,9 +11,11 @@
 #pragma once
 #include <JuceHeader.h>
 #include "RotarySliderWithLabels.h"
+#include "SwitchableAttachments.h"
+#include "FrameScheduler.h"
 
 
-struct CompressorBandControls : juce::Component, juce::Button::Listener
+struct CompressorBandControls : juce::Component, juce::Button::Listener, FrameScheduler::Client
 {
     CompressorBandControls(juce::AudioProcessorValueTreeState& apvts);
     ~CompressorBandControls() override;
@@ -23,17 +25,35 @@ struct CompressorBandControls : juce::Component, juce::Button::Listener
     void buttonClicked(juce::Button* button) override;
 
     void toggleAllBands(bool shouldBeBypassed);
+
+    //shows the latest automation on the active band's sliders.
+    bool updateFrame() override;
 private:
     juce::AudioProcessorValueTreeState& apvts;
 
     RotarySliderWithLabels attackSlider, releaseSlider, thresholdSlider;
     RatioSlider ratioSlider;
 
-    using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
-    std::unique_ptr<Attachment> attackSliderAttachment, releaseSliderAttachment, thresholdSliderAttachment, ratioSliderAttachment;
+    enum BandControl
+    {
+        Attack,
+        Release,
+        Threshold,
+        Ratio,
+        Mute,
+        Solo,
+        Bypass,
+        NumBandControls
+    };
+
+    //[band][BandControl], looked up once in the constructor.
+    std::array<std::array<juce::RangedAudioParameter*, NumBandControls>, 3> bandParams;
+
+    //every band's attachments are made once; switching bands only changes which one is active.
+    std::unique_ptr<SwitchableSliderAttachment> attackSliderAttachment, releaseSliderAttachment, thresholdSliderAttachment, ratioSliderAttachment;
+    std::unique_ptr<SwitchableButtonAttachment> bypassButtonAttachment, soloButtonAttachment, muteButtonAttachment;
 
-    using BtnAttachment = juce::AudioProcessorValueTreeState::ButtonAttachment;
-    std::unique_ptr<BtnAttachment> bypassButtonAttachment, soloButtonAttachment, muteButtonAttachment;
+    void createAttachments();
 
     juce::Component::SafePointer<CompressorBandControls> safePtr{ this };
     void updateAttachments();
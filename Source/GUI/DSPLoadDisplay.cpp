@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    DSPLoadDisplay.cpp
+    Created: 19 Oct 2026 11:31:52pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "DSPLoadDisplay.h"
+
+bool DSPLoadDisplay::update(DSPLoadMeter& meter)
+{
+    auto now = juce::Time::getMillisecondCounter();
+
+    if (!hasTotals)
+    {
+        //what came before this editor belongs to nobody watching.
+        lastTotals = meter.getTotals();
+        overrunsAtOpen = lastTotals.numOverruns;
+        meter.takePeakLoad();
+        lastRefreshMs = now;
+        hasTotals = true;
+        return false;
+    }
+
+    if (now - lastRefreshMs < refreshIntervalMs)
+        return false;
+
+    lastRefreshMs = now;
+
+    auto totals = meter.getTotals();
+    auto peak = meter.takePeakLoad();
+
+    //no blocks (transport stopped, or the host isn't calling us): keep the last numbers up.
+    if (totals.numBlocks == lastTotals.numBlocks)
+        return false;
+
+    auto newAverage = (float)((totals.loadSum - lastTotals.loadSum) / (double)(totals.numBlocks - lastTotals.numBlocks));
+    auto newOverruns = totals.numOverruns - overrunsAtOpen;
+    lastTotals = totals;
+
+    auto percent = [](float load) { return juce::roundToInt(load * 100.f); };
+    if (percent(newAverage) == percent(averageLoad) && percent(peak) == percent(peakLoad) && newOverruns == overrunsSinceOpened)
+        return false;
+
+    averageLoad = newAverage;
+    peakLoad = peak;
+    overrunsSinceOpened = newOverruns;
+    repaint();
+    return true;
+}
+
+void DSPLoadDisplay::paint(juce::Graphics& g)
+{
+    auto bounds = getLocalBounds();
+    auto top = bounds.removeFromTop(bounds.getHeight() / 2);
+
+    g.setFont(10.f);
+
+    auto loadColor = peakLoad >= 1.f ? juce::Colours::red
+                   : peakLoad >= 0.7f ? juce::Colours::orange
+                   : juce::Colours::lightgrey;
+    g.setColour(loadColor);
+    g.drawFittedText(juce::String(juce::roundToInt(averageLoad * 100.f)) + "/" + juce::String(juce::roundToInt(peakLoad * 100.f)) + "%",
+                     top, juce::Justification::centredRight, 1);
+
+    g.setColour(overrunsSinceOpened > 0 ? juce::Colours::red : juce::Colours::grey);
+    g.drawFittedText(juce::String((juce::int64)overrunsSinceOpened) + " over",
+                     bounds, juce::Justification::centredRight, 1);
+}
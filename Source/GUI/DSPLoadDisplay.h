@@ -0,0 +1,36 @@
+/*
+  ==============================================================================
+
+    DSPLoadDisplay.h
+    Created: 19 Oct 2026 11:31:52pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../DSP/DSPLoadMeter.h"
+
+/*
+ "avg/peak%" of the block deadline processBlock() used since the last refresh,
+ over the number of blocks that missed their deadline since the editor opened.
+ refreshed a few times a second so the numbers can be read.
+ */
+struct DSPLoadDisplay : juce::Component
+{
+    //call every editor frame. returns true if the text changed.
+    bool update(DSPLoadMeter& meter);
+
+    void paint(juce::Graphics& g) override;
+
+    static constexpr juce::uint32 refreshIntervalMs = 250;
+private:
+    DSPLoadMeter::Totals lastTotals;
+    bool hasTotals = false;
+    juce::uint32 lastRefreshMs = 0;
+
+    float averageLoad = 0.f, peakLoad = 0.f;
+    juce::uint64 overrunsSinceOpened = 0;
+    juce::uint64 overrunsAtOpen = 0;
+};
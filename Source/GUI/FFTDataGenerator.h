@@ -11,6 +11,16 @@
 #pragma once
 #include <JuceHeader.h>
 #include "../PluginProcessor.h"
+#include "FastDecibels.h"
+#include "../DSP/Fifo.h"
+
+/*
+ one background thread, shared by every FFTDataGenerator, that builds FFT plans and windows.
+ */
+struct FFTPlanBuilder
+{
+    juce::ThreadPool pool{ 1 };
+};
 
 template<typename BlockType>
 struct FFTDataGenerator
@@ -20,78 +30,102 @@ struct FFTDataGenerator
      */
     void produceFFTDataForRendering(const juce::AudioBuffer<float>& audioData, const float negativeInfinity)
     {
+        jassert(plan != nullptr);
         const auto fftSize = getFFTSize();
+        auto& fftData = plan->fftData;
 
-        fftData.assign(fftData.size(), 0);
+        // only the first fftSize samples are input, the upper half is scratch for the transform.
         auto* readIndex = audioData.getReadPointer(0);
         std::copy(readIndex, readIndex + fftSize, fftData.begin());
 
         // first apply a windowing function to our data
-        window->multiplyWithWindowingTable(fftData.data(), fftSize);       // [1]
+        plan->window.multiplyWithWindowingTable(fftData.data(), fftSize);       // [1]
 
         // then render our FFT data..
-        forwardFFT->performFrequencyOnlyForwardTransform(fftData.data());  // [2]
+        plan->forwardFFT.performFrequencyOnlyForwardTransform(fftData.data());  // [2]
 
         int numBins = (int)fftSize / 2;
 
-        //normalize the fft values.
-        for (int i = 0; i < numBins; ++i)
-        {
-            auto v = fftData[i];
-            //            fftData[i] /= (float) numBins;
-            if (!std::isinf(v) && !std::isnan(v))
-            {
-                v /= float(numBins);
-            }
-            else
-            {
-                v = 0.f;
-            }
-            fftData[i] = v;
-        }
+        //normalize the fft values and convert them to decibels in a single pass.
+        convertMagnitudesToDecibels(fftData.data(), numBins, 1.f / float(numBins), negativeInfinity);
 
-        float max = negativeInfinity;
-
-        //convert them to decibels
-        for (int i = 0; i < numBins; ++i)
-        {
-            auto data = juce::Decibels::gainToDecibels(fftData[i], negativeInfinity);
-            fftData[i] = data;
-            max = juce::jmax(data, max);
-        }
-        
-        
-
-        fftDataFifo.push(fftData);
+        //only the bins are queued, not the scratch half.
+        fftDataFifo.pushLatest(fftData.data(), (size_t)numBins);
     }
 
+    /*
+     the window, forwardFFT and fftData for 'newOrder' are built on a background thread.
+     nothing changes until the consumer calls installPendingPlan().
+     */
     void changeOrder(FFTOrder newOrder)
     {
-        //when you change order, recreate the window, forwardFFT, fifo, fftData
-        //also reset the fifoIndex
-        //things that need recreating should be created on the heap via std::make_unique<>
-
-        order = newOrder;
-        auto fftSize = getFFTSize();
+        planBuilder->pool.addJob([mailbox = this->mailbox, newOrder]()
+            {
+                mailbox->post(std::make_unique<Plan>(newOrder));
+            });
+    }
 
-        forwardFFT = std::make_unique<juce::dsp::FFT>(order);
-        window = std::make_unique<juce::dsp::WindowingFunction<float>>(fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris);
+    /*
+     call from the thread that produces and consumes the fft data.
+     returns true if a new plan was swapped in, in which case any queued fft data has been dropped.
+     */
+    bool installPendingPlan()
+    {
+        auto newPlan = mailbox->collect();
+        if (newPlan == nullptr)
+            return false;
 
-        fftData.clear();
-        fftData.resize(fftSize * 2, 0);
+        plan = std::move(newPlan);
 
-        fftDataFifo.prepare(fftData.size());
+        fftDataFifo.reset();
+        fftDataFifo.prepare((size_t)getFFTSize() / 2);
+        return true;
     }
     //==============================================================================
-    int getFFTSize() const { return 1 << order; }
+    int getFFTSize() const { return plan != nullptr ? 1 << plan->order : 0; }
     int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
     //==============================================================================
     bool getFFTData(BlockType& fftData) { return fftDataFifo.pull(fftData); }
 private:
-    FFTOrder order;
-    BlockType fftData;
-    std::unique_ptr<juce::dsp::FFT> forwardFFT;
-    std::unique_ptr<juce::dsp::WindowingFunction<float>> window;
+    struct Plan
+    {
+        explicit Plan(FFTOrder o) :
+            order(o),
+            forwardFFT(o),
+            window(size_t(1) << o, juce::dsp::WindowingFunction<float>::blackmanHarris)
+        {
+            fftData.resize(size_t(2) << o, 0);
+        }
+
+        FFTOrder order;
+        juce::dsp::FFT forwardFFT;
+        juce::dsp::WindowingFunction<float> window;
+        BlockType fftData;
+    };
 
-    Fifo<BlockType> fftDataFifo;
+    /*
+     single slot handoff between the plan builder and the consumer. the latest posted plan wins.
+     held by shared_ptr so a job still running after this generator is gone has somewhere to write.
+     */
+    struct PlanMailbox
+    {
+        ~PlanMailbox() { delete pending.exchange(nullptr); }
+
+        void post(std::unique_ptr<Plan> newPlan) { delete pending.exchange(newPlan.release()); }
+        std::unique_ptr<Plan> collect() { return std::unique_ptr<Plan>(pending.exchange(nullptr)); }
+
+        std::atomic<Plan*> pending{ nullptr };
+    };
+
+    std::unique_ptr<Plan> plan;
+    std::shared_ptr<PlanMailbox> mailbox{ std::make_shared<PlanMailbox>() };
+    juce::SharedResourcePointer<FFTPlanBuilder> planBuilder;
+
+    /*
+     produced and consumed on the same thread, so this only has to hold the frames made in
+     one pass: a frame's worth of audio at 192kHz is about 13 hops of the smallest FFT at 8x overlap.
+     if more arrive the oldest are dropped.
+     */
+    static constexpr int fftDataCapacity = 16;
+    Fifo<BlockType> fftDataFifo{ fftDataCapacity };
 };
@@ -0,0 +1,72 @@
+/*
+  ==============================================================================
+
+    FrameScheduler.cpp
+    Created: 19 Oct 2026 3:48:10pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "FrameScheduler.h"
+
+FrameScheduler::FrameScheduler(juce::Component& ownerToWatch) :
+    owner(ownerToWatch)
+{
+}
+
+FrameScheduler::~FrameScheduler()
+{
+    stopTimer();
+}
+
+void FrameScheduler::addClient(Client* client)
+{
+    jassert(client != nullptr);
+    if (std::find(clients.begin(), clients.end(), client) == clients.end())
+        clients.push_back(client);
+}
+
+void FrameScheduler::removeClient(Client* client)
+{
+    clients.erase(std::remove(clients.begin(), clients.end(), client), clients.end());
+}
+
+void FrameScheduler::start()
+{
+    unchangedFrames = 0;
+    setRate(activeRateHz);
+}
+
+void FrameScheduler::timerCallback()
+{
+    //minimised or hidden: keep the fifos drained, but nothing needs to look smooth.
+    if (!owner.isShowing())
+    {
+        setRate(hiddenRateHz);
+        for (auto* client : clients)
+            client->updateFrame();
+
+        return;
+    }
+
+    bool anythingChanged = false;
+    for (auto* client : clients)
+        anythingChanged = client->updateFrame() || anythingChanged;
+
+    if (anythingChanged)
+    {
+        unchangedFrames = 0;
+        setRate(activeRateHz);
+    }
+    else if (++unchangedFrames >= framesBeforeIdle)
+    {
+        setRate(idleRateHz);
+    }
+}
+
+void FrameScheduler::setRate(int rateHz)
+{
+    if (!isTimerRunning() || getTimerInterval() != 1000 / rateHz)
+        startTimerHz(rateHz);
+}
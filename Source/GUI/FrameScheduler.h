@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    FrameScheduler.h
+    Created: 19 Oct 2026 3:48:10pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+
+#include <JuceHeader.h>
+#include <algorithm>
+#include <vector>
+
+/*
+ the one place the editor's animation is driven from. every frame each client pulls its
+ data and repaints whatever it needs to itself; the scheduler never repaints anything.
+
+ the rate drops while the owner isn't on screen, and after a run of frames where no client
+ reported a change. any change brings it straight back up.
+
+ JUCE 6.1 has no VBlankAttachment, so the frames come from a single Timer.
+ */
+struct FrameScheduler : juce::Timer
+{
+    struct Client
+    {
+        virtual ~Client() = default;
+
+        //return true if anything new was shown this frame.
+        virtual bool updateFrame() = 0;
+    };
+
+    FrameScheduler(juce::Component& ownerToWatch);
+    ~FrameScheduler() override;
+
+    //clients are updated in the order they were added.
+    void addClient(Client* client);
+    void removeClient(Client* client);
+
+    void start();
+
+    void timerCallback() override;
+
+    static constexpr int activeRateHz = 60;
+    static constexpr int idleRateHz = 15;
+    static constexpr int hiddenRateHz = 4;
+private:
+    juce::Component& owner;
+    std::vector<Client*> clients;
+
+    //half a second at the active rate.
+    static constexpr int framesBeforeIdle = activeRateHz / 2;
+    int unchangedFrames = 0;
+
+    void setRate(int rateHz);
+};
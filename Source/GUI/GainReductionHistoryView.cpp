@@ -0,0 +1,116 @@
+/*
+  ==============================================================================
+
+    GainReductionHistoryView.cpp
+    Created: 19 Oct 2026 6:47:31pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "GainReductionHistoryView.h"
+#include "LookAnFeel.h"
+#include "Utilities.h"
+
+GainReductionHistoryView::GainReductionHistoryView()
+{
+    setOpaque(true);
+}
+
+void GainReductionHistoryView::addBlock(const std::array<float, 3>& gainReductiondB, int numSamples, double sampleRate)
+{
+    if (sampleRate <= 0.0)
+        return;
+
+    for (size_t band = 0; band < pendingColumn.size(); ++band)
+        pendingColumn[band] = juce::jmin(pendingColumn[band], gainReductiondB[band]);
+
+    pendingSeconds += numSamples / sampleRate;
+    if (pendingSeconds < 1.0 / columnsPerSecond)
+        return;
+
+    //a block longer than a column fills several with the same reduction.
+    while (pendingSeconds >= 1.0 / columnsPerSecond)
+    {
+        pushColumn(pendingColumn);
+        pendingSeconds -= 1.0 / columnsPerSecond;
+    }
+
+    //what's left of this block starts the next column.
+    pendingColumn = pendingSeconds > 0.0 ? gainReductiondB : std::array<float, 3>{ 0.f, 0.f, 0.f };
+}
+
+bool GainReductionHistoryView::flush()
+{
+    auto shouldRepaint = columnsAdded && isShowing();
+    if (shouldRepaint)
+        repaint(getDisplayArea());
+
+    columnsAdded = false;
+    return shouldRepaint;
+}
+
+void GainReductionHistoryView::pushColumn(const std::array<float, 3>& gainReductiondB)
+{
+    if (history.empty())
+        return;
+
+    history[nextColumn] = gainReductiondB;
+    nextColumn = (nextColumn + 1) % (int)history.size();
+    columnsAdded = true;
+}
+
+void GainReductionHistoryView::paint(juce::Graphics& g)
+{
+    drawModuleBackground(g, getLocalBounds());
+
+    auto area = getDisplayArea();
+    g.setColour(juce::Colours::black);
+    g.fillRect(area);
+
+    if (history.empty())
+        return;
+
+    const auto numColumns = (int)history.size();
+    const auto top = (float)area.getY();
+    const auto bottom = (float)area.getBottom();
+
+    for (size_t band = 0; band < traces.size(); ++band)
+    {
+        auto& trace = traces[band];
+        trace.startNewSubPath(0.f, 0.f);
+        trace.ys.resize((size_t)numColumns);
+
+        //oldest column first, so the newest ends up on the right.
+        for (int x = 0; x < numColumns; ++x)
+        {
+            auto gr = history[(nextColumn + x) % numColumns][band];
+            trace.ys[(size_t)x] = juce::jmap(juce::jlimit(-maxGainReductiondB, 0.f, gr), 0.f, -maxGainReductiondB, top, bottom);
+        }
+    }
+
+    renderer.begin(area.getWidth(), area.getHeight(), g.getInternalContext().getPhysicalPixelScaleFactor());
+
+    const AnalyzerTap bandTaps[] = { LowBandTap, MidBandTap, HighBandTap };
+    for (size_t band = 0; band < traces.size(); ++band)
+        renderer.drawTrace(traces[band], -top, ColorScheme::getAnalyzerTapColor(bandTaps[band]));
+
+    renderer.draw(g, area);
+}
+
+void GainReductionHistoryView::resized()
+{
+    history.assign((size_t)juce::jmax(0, getDisplayArea().getWidth()), { 0.f, 0.f, 0.f });
+    nextColumn = 0;
+}
+
+juce::Rectangle<int> GainReductionHistoryView::getDisplayArea() const
+{
+    //lined up with SpectrumAnalyzer's analysis area.
+    auto bounds = getLocalBounds().reduced(3);
+    bounds.removeFromLeft(20);
+    bounds.removeFromRight(20);
+    bounds.removeFromTop(4);
+    bounds.removeFromBottom(4);
+    return bounds;
+}
@@ -0,0 +1,54 @@
+/*
+  ==============================================================================
+
+    GainReductionHistoryView.h
+    Created: 19 Oct 2026 6:47:31pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include "SpectrumTraceRenderer.h"
+
+/*
+ a scrolling line per band of gain reduction, newest on the right.
+ it scrolls with the audio, not the editor's frame rate: each column covers 1/columnsPerSecond
+ of processed audio and holds the deepest reduction of the blocks in it.
+ */
+struct GainReductionHistoryView : juce::Component
+{
+    GainReductionHistoryView();
+
+    //one processBlock()'s worth of gain reduction. a column is added for every 1/columnsPerSecond of audio.
+    void addBlock(const std::array<float, 3>& gainReductiondB, int numSamples, double sampleRate);
+
+    //repaints if any columns were added since the last call, and returns true if it did.
+    bool flush();
+
+    static constexpr int columnsPerSecond = 60;
+
+    void paint(juce::Graphics& g) override;
+    void resized() override;
+
+    static constexpr float maxGainReductiondB = 24.f;
+private:
+    //ring of columns, 'nextColumn' is the oldest.
+    std::vector<std::array<float, 3>> history;
+    int nextColumn = 0;
+    bool columnsAdded = false;
+
+    //the column being filled.
+    std::array<float, 3> pendingColumn{ 0.f, 0.f, 0.f };
+    double pendingSeconds = 0.0;
+
+    void pushColumn(const std::array<float, 3>& gainReductiondB);
+
+    std::array<SpectrumTrace, 3> traces;
+    SpectrumTraceRenderer renderer;
+
+    juce::Rectangle<int> getDisplayArea() const;
+};
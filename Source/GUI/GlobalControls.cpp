@@ -54,6 +54,15 @@ GlobalControls::GlobalControls(juce::AudioProcessorValueTreeState& apvts)
     addAndMakeVisible(*outGainSlider);
 }
 
+bool GlobalControls::updateFrame()
+{
+    bool changed = false;
+    for (auto* attachment : { inGainSliderAttachment.get(), lowMidXoverSliderAttachment.get(), midHighXoverSliderAttachment.get(), outGainSliderAttachment.get() })
+        changed = attachment->updateFrame() || changed;
+
+    return changed;
+}
+
 void GlobalControls::paint(juce::Graphics& g)
 {
     auto bounds = getLocalBounds();
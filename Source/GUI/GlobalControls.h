@@ -11,18 +11,23 @@
 #pragma once
 #include <JuceHeader.h>
 #include "RotarySliderWithLabels.h"
+#include "SwitchableAttachments.h"
+#include "FrameScheduler.h"
 
-struct GlobalControls : juce::Component
+struct GlobalControls : juce::Component, FrameScheduler::Client
 {
     GlobalControls(juce::AudioProcessorValueTreeState& apvts);
 
     void paint(juce::Graphics& g) override;
 
     void resized() override;
+
+    //shows the latest automation on the sliders.
+    bool updateFrame() override;
 private:
     using RSWL = RotarySliderWithLabels;
     std::unique_ptr<RSWL> inGainSlider, lowMinXoverSlider, midHighXoverSlider, outGainSlider;
 
-    using Attachment = juce::AudioProcessorValueTreeState::SliderAttachment;
+    using Attachment = SwitchableSliderAttachment;
     std::unique_ptr<Attachment> lowMidXoverSliderAttachment, midHighXoverSliderAttachment, inGainSliderAttachment, outGainSliderAttachment;
 };
\ No newline at end of file
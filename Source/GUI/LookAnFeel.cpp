@@ -22,48 +22,37 @@ void LookAndFeel::drawRotarySlider(juce::Graphics& g,
     using namespace juce;
 
     auto bounds = Rectangle<float>(x, y, width, height);
-    auto enabled = slider.isEnabled();
-
-    g.setColour(enabled ? ColorScheme::getSliderFillColor()   : ColorScheme::getSliderDisabledColor()); // rotary slider fill
-    g.fillEllipse(bounds);
-    g.setColour(enabled ? ColorScheme::getSliderBorderColor() : ColorScheme::getSliderBorderColor()); // rotary slider outline
-    g.drawEllipse(bounds, 2.f);
 
-    if (auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider))
+    auto* rswl = dynamic_cast<RotarySliderWithLabels*>(&slider);
+    if (rswl == nullptr)
     {
-        auto center = bounds.getCentre();
-        Path p;
-
-        Rectangle<float> r;
-        r.setLeft(center.getX() - 1);
-        r.setRight(center.getX() + 1);
-        r.setTop(bounds.getY());
-        r.setBottom(center.getY() - rswl->getTextHeight() * 2.5);
-
-        p.addRoundedRectangle(r, 1.f);
-        jassert(rotaryStartAngle < rotaryEndAngle);
-
-        auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
-
-
-        p.applyTransform(AffineTransform().rotated(sliderAngRad, center.getX(), center.getY()));
+        drawRotarySliderBackground(g, bounds, slider);
+        return;
+    }
 
-        g.fillPath(p);
+    jassert(rotaryStartAngle < rotaryEndAngle);
+    auto sliderAngRad = jmap(sliderPosProportional, 0.f, 1.f, rotaryStartAngle, rotaryEndAngle);
+    auto center = bounds.getCentre();
 
-        g.setFont(rswl->getTextHeight());
-        auto text = rswl->getDisplayString();
-        auto strWidth = g.getCurrentFont().getStringWidth(text);
+    g.setColour(ColorScheme::getSliderBorderColor()); // pointer
+    g.fillPath(rswl->getPointerPath(), AffineTransform::rotation(sliderAngRad, center.getX(), center.getY()));
 
-        r.setSize(strWidth , rswl->getTextHeight() + 2);
-        r.setCentre(center);
+    g.setColour(Colours::black); // label text
+    rswl->getValueText().glyphs.draw(g, AffineTransform::translation(center));
+}
 
-        g.setColour(Colours::transparentBlack); // rotary label back colours
-        g.fillRect(r);
+void LookAndFeel::drawRotarySliderBackground(juce::Graphics& g,
+    juce::Rectangle<float> bounds,
+    const juce::Slider& slider)
+{
+    using namespace juce;
 
-        g.setColour(Colours::black); // label text
-        g.drawFittedText(text, r.toNearestInt(), juce::Justification::centred, 1);
-    }
+    auto enabled = slider.isEnabled();
 
+    g.setColour(enabled ? ColorScheme::getSliderFillColor()   : ColorScheme::getSliderDisabledColor()); // rotary slider fill
+    g.fillEllipse(bounds);
+    g.setColour(enabled ? ColorScheme::getSliderBorderColor() : ColorScheme::getSliderBorderColor()); // rotary slider outline
+    g.drawEllipse(bounds, 2.f);
 }
 
 void LookAndFeel::drawToggleButton(juce::Graphics& g,
@@ -11,6 +11,7 @@
 #pragma once
 
 #include <JuceHeader.h>
+#include "Utilities.h"
 
 #define USE_LIVE_CONTANT false
 
@@ -34,6 +35,17 @@ inline juce::Colour getSliderDisabledColor()
 {
     return colorHelper(juce::Colours::darkslategrey);
 }
+inline juce::Colour getAnalyzerTapColor(int tap)
+{
+    switch (tap)
+    {
+        case OutputTap:   return colorHelper(juce::Colours::orange);
+        case LowBandTap:  return colorHelper(juce::Colours::deepskyblue);
+        case MidBandTap:  return colorHelper(juce::Colours::gold);
+        case HighBandTap: return colorHelper(juce::Colours::hotpink);
+        default:          return colorHelper(juce::Colours::forestgreen);
+    }
+}
 }
 
 
@@ -47,6 +59,14 @@ struct LookAndFeel : juce::LookAndFeel_V4
         float rotaryEndAngle,
         juce::Slider&) override;
 
+    /*
+     the knob body. RotarySliderWithLabels keeps this in its cached layer, so for
+     those drawRotarySlider() only draws the pointer and the value text.
+     */
+    void drawRotarySliderBackground(juce::Graphics&,
+        juce::Rectangle<float> bounds,
+        const juce::Slider&);
+
     void drawToggleButton(juce::Graphics& g,
         juce::ToggleButton& toggleButton,
         bool shouldDrawButtonAsHighlighted,
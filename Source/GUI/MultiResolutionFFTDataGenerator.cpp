@@ -0,0 +1,269 @@
+/*
+  ==============================================================================
+
+    MultiResolutionFFTDataGenerator.cpp
+    Created: 19 Oct 2026 1:05:48pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "MultiResolutionFFTDataGenerator.h"
+#include "Utilities.h"
+#include "FastDecibels.h"
+
+HalfBandDecimator::HalfBandDecimator()
+{
+    //blackman windowed sinc with the cutoff at a quarter of the sample rate.
+    const auto pi = juce::MathConstants<double>::pi;
+    std::array<double, numTaps> taps;
+    double sum = 0.0;
+
+    for (int n = 0; n < numTaps; ++n)
+    {
+        auto offset = n - centre;
+        auto sinc = offset == 0 ? 0.5 : std::sin(pi * 0.5 * offset) / (pi * offset);
+        auto blackman = 0.42
+                      - 0.5 * std::cos(2.0 * pi * n / (numTaps - 1))
+                      + 0.08 * std::cos(4.0 * pi * n / (numTaps - 1));
+
+        //an even distance from the centre lands on a zero of the sinc.
+        taps[n] = (offset != 0 && offset % 2 == 0) ? 0.0 : sinc * blackman;
+        sum += taps[n];
+    }
+
+    //unity gain at DC
+    centreCoefficient = static_cast<float>(taps[centre] / sum);
+    for (int k = 0; k < numTapPairs; ++k)
+        pairCoefficients[k] = static_cast<float>(taps[2 * k] / sum);
+
+    reset();
+}
+
+void HalfBandDecimator::reset()
+{
+    history.fill(0.f);
+    writeIndex = 0;
+    skipNextOutput = false;
+}
+
+int HalfBandDecimator::process(const float* input, int numSamples, float* output)
+{
+    int numOutputSamples = 0;
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        history[writeIndex] = input[i];
+        history[writeIndex + numTaps] = input[i];
+        writeIndex = (writeIndex + 1) % numTaps;
+
+        if (skipNextOutput)
+        {
+            skipNextOutput = false;
+            continue;
+        }
+
+        //oldest sample first. the zero taps are skipped and each pair of mirrored taps shares a multiply.
+        const auto* taps = history.data() + writeIndex;
+        auto sum = taps[centre] * centreCoefficient;
+        for (int k = 0; k < numTapPairs; ++k)
+            sum += (taps[2 * k] + taps[numTaps - 1 - 2 * k]) * pairCoefficients[k];
+
+        output[numOutputSamples++] = sum;
+        skipNextOutput = true;
+    }
+
+    return numOutputSamples;
+}
+//==============================================================================
+MultiResolutionFFTDataGenerator::MultiResolutionFFTDataGenerator()
+{
+    for (auto& stage : stages)
+    {
+        stage.history.assign(fftSize, 0.f);
+        stage.spectrum.assign(numBins, NEGATIVE_INFINITY);
+    }
+
+    fftScratch.resize(fftSize * 2, 0.f);
+    mergedFrame.resize(numPoints, NEGATIVE_INFINITY);
+    fftDataFifo.prepare(numPoints);
+}
+
+void MultiResolutionFFTDataGenerator::prepare(double sampleRate)
+{
+    if (sampleRate == preparedSampleRate || sampleRate <= 0.0)
+        return;
+
+    preparedSampleRate = sampleRate;
+
+    //the decimators leave each stage clean up to ~40% of its own sample rate (all of it for stage 0).
+    constexpr double usableFraction = 0.4;
+
+    auto stageForFrequency = [sampleRate](double freq)
+        {
+            int stage = 0;
+            while (stage + 1 < numStages && freq <= usableFraction * sampleRate / double(1 << (stage + 1)))
+                ++stage;
+
+            return stage;
+        };
+
+    auto pointToFreq = [](float point)
+        {
+            return juce::mapToLog10(point / float(numPoints - 1), MIN_FREQUENCY, MAX_FREQUENCY);
+        };
+
+    for (int i = 0; i < numPoints; ++i)
+    {
+        auto& m = mapping[i];
+        m.stage = stageForFrequency(pointToFreq(float(i)));
+
+        auto binWidth = float(sampleRate / double(1 << m.stage) / double(fftSize));
+
+        auto lastBin = float(numBins - 1);
+        m.binPosition = juce::jlimit(0.f, lastBin, pointToFreq(float(i)) / binWidth);
+        m.firstBin = juce::jlimit(0, numBins - 1, (int)std::ceil(pointToFreq(float(i) - 0.5f) / binWidth));
+        m.lastBin = juce::jlimit(0, numBins, (int)std::ceil(pointToFreq(float(i) + 0.5f) / binWidth));
+    }
+
+    reset();
+}
+
+void MultiResolutionFFTDataGenerator::reset()
+{
+    for (auto& stage : stages)
+    {
+        stage.decimator.reset();
+        std::fill(stage.history.begin(), stage.history.end(), 0.f);
+        std::fill(stage.spectrum.begin(), stage.spectrum.end(), NEGATIVE_INFINITY);
+        stage.samplesSinceLastFFT = 0;
+    }
+
+    fftDataFifo.reset();
+}
+
+void MultiResolutionFFTDataGenerator::setHopSize(int numSamples)
+{
+    hopSize = juce::jmax(1, numSamples);
+
+    //a smaller hop shouldn't make a burst of FFTs.
+    for (auto& stage : stages)
+        stage.samplesSinceLastFFT = juce::jmin(stage.samplesSinceLastFFT, hopSize - 1);
+}
+
+int MultiResolutionFFTDataGenerator::pushSamples(const float* samples, int numSamples, float negativeInfinity)
+{
+    int numFrames = 0;
+
+    //up to the next stage 0 hop at a time, so every hop is merged with the lower stages as they were then.
+    while (numSamples > 0)
+    {
+        auto size = juce::jmin(numSamples, hopSize - stages[0].samplesSinceLastFFT);
+
+        if (pushIntoCascade(samples, size, negativeInfinity))
+        {
+            mergeStages();
+            fftDataFifo.pushLatest(mergedFrame);
+            ++numFrames;
+        }
+
+        samples += size;
+        numSamples -= size;
+    }
+
+    return numFrames;
+}
+
+bool MultiResolutionFFTDataGenerator::pushIntoCascade(const float* samples, int numSamples, float negativeInfinity)
+{
+    const float* input = samples;
+    int numInput = numSamples;
+    bool topStageUpdated = false;
+
+    for (int s = 0; s < numStages && numInput > 0; ++s)
+    {
+        auto numFFTs = pushIntoStage(s, input, numInput, negativeInfinity);
+        topStageUpdated = topStageUpdated || (s == 0 && numFFTs > 0);
+
+        if (s + 1 < numStages)
+        {
+            //ping-pong between the two scratch buffers so input and output never alias.
+            auto& output = (s % 2 == 0) ? decimated : decimatedNext;
+            if ((int)output.size() < numInput / 2 + 1)
+                output.resize(numInput / 2 + 1);
+
+            numInput = stages[s].decimator.process(input, numInput, output.data());
+            input = output.data();
+        }
+    }
+
+    //stage 0 updates most often, so it sets the frame rate.
+    return topStageUpdated;
+}
+
+int MultiResolutionFFTDataGenerator::pushIntoStage(int stageIndex, const float* samples, int numSamples, float negativeInfinity)
+{
+    auto& stage = stages[stageIndex];
+    auto& history = stage.history;
+    int numFFTs = 0;
+
+    //one FFT per hop, each from the history as it stood at the end of that hop.
+    while (numSamples > 0)
+    {
+        auto size = juce::jmin(numSamples, hopSize - stage.samplesSinceLastFFT);
+
+        if (auto samplesToKeep = fftSize - size; samplesToKeep > 0)
+            std::copy(history.begin() + size, history.end(), history.begin());
+
+        std::copy(samples, samples + size, history.end() - size);
+
+        samples += size;
+        numSamples -= size;
+        stage.samplesSinceLastFFT += size;
+
+        if (stage.samplesSinceLastFFT >= hopSize)
+        {
+            stage.samplesSinceLastFFT -= hopSize;
+            analyzeStage(stage, negativeInfinity);
+            ++numFFTs;
+        }
+    }
+
+    return numFFTs;
+}
+
+void MultiResolutionFFTDataGenerator::analyzeStage(Stage& stage, float negativeInfinity)
+{
+    std::copy(stage.history.begin(), stage.history.end(), fftScratch.begin());
+    window.multiplyWithWindowingTable(fftScratch.data(), fftSize);
+    forwardFFT.performFrequencyOnlyForwardTransform(fftScratch.data());
+    convertMagnitudesToDecibels(fftScratch.data(), numBins, 1.f / float(numBins), negativeInfinity);
+
+    std::copy(fftScratch.begin(), fftScratch.begin() + numBins, stage.spectrum.begin());
+}
+
+void MultiResolutionFFTDataGenerator::mergeStages()
+{
+    for (int i = 0; i < numPoints; ++i)
+    {
+        const auto& m = mapping[i];
+        const auto& spectrum = stages[m.stage].spectrum;
+
+        if (m.lastBin > m.firstBin + 1)
+        {
+            //more than one bin between neighbouring points: keep the peak so narrow tones don't vanish.
+            auto peak = spectrum[m.firstBin];
+            for (int bin = m.firstBin + 1; bin < m.lastBin; ++bin)
+                peak = juce::jmax(peak, spectrum[bin]);
+
+            mergedFrame[i] = peak;
+        }
+        else
+        {
+            auto index = (int)m.binPosition;
+            auto next = juce::jmin(index + 1, numBins - 1);
+            auto frac = m.binPosition - (float)index;
+            mergedFrame[i] = spectrum[index] + frac * (spectrum[next] - spectrum[index]);
+        }
+    }
+}
@@ -0,0 +1,111 @@
+/*
+  ==============================================================================
+
+    MultiResolutionFFTDataGenerator.h
+    Created: 19 Oct 2026 1:05:48pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <vector>
+#include "../DSP/Fifo.h"
+
+/*
+ FIR half-band lowpass followed by a decimate-by-2.
+ every other tap of a half-band filter is zero and the rest are symmetric, so each output
+ only costs one multiply per pair of non-zero taps plus one for the centre.
+ */
+struct HalfBandDecimator
+{
+    HalfBandDecimator();
+
+    //writes numSamples / 2 (give or take one) samples to 'output', returns how many.
+    int process(const float* input, int numSamples, float* output);
+    void reset();
+private:
+    static constexpr int numTaps = 63;
+    static constexpr int centre = numTaps / 2;
+    //taps 0, 2, 4... below the centre, each shared with its mirror above it.
+    static constexpr int numTapPairs = (centre + 1) / 2;
+    std::array<float, numTapPairs> pairCoefficients;
+    float centreCoefficient = 0.5f;
+    std::array<float, numTaps * 2> history; //doubled so the taps can always be read contiguously
+    int writeIndex = 0;
+    bool skipNextOutput = false;
+};
+
+/*
+ a constant-Q style analyzer: a cascade of half-band decimators where each stage runs a
+ small FFT on its own octave range. the stages are merged into 'numPoints' dB values
+ spaced evenly in log frequency between MIN_FREQUENCY and MAX_FREQUENCY.
+
+ stage k runs an FFT every 'hopSize' of its own samples, i.e. every hopSize * 2^k input samples,
+ so lower stages get finer bins and update less often. against an 8192 point FFT at the same hop
+ that's about two 2048 point FFTs per hop instead of one 8192 point one (~40% of the work),
+ and the lowest stage's bins are 8x finer: a single FFT would need 65536 points to match them.
+ a merged frame is made for every stage 0 hop, however many hops one push spans.
+ */
+struct MultiResolutionFFTDataGenerator
+{
+    static constexpr int numStages = 6;
+    static constexpr int numPoints = 1024;
+
+    MultiResolutionFFTDataGenerator();
+
+    //rebuilds the point -> stage/bin table if the sample rate changed.
+    void prepare(double sampleRate);
+    void reset();
+
+    void setHopSize(int numSamples);
+
+    //returns how many frames were made.
+    int pushSamples(const float* samples, int numSamples, float negativeInfinity);
+    //==============================================================================
+    int getNumAvailableFFTDataBlocks() const { return fftDataFifo.getNumAvailableForReading(); }
+    bool getFFTData(std::vector<float>& data) { return fftDataFifo.pull(data); }
+private:
+    static constexpr int order = 11;
+    static constexpr int fftSize = 1 << order;
+    static constexpr int numBins = fftSize / 2;
+
+    struct Stage
+    {
+        HalfBandDecimator decimator;    //feeds the next stage
+        std::vector<float> history;     //last fftSize samples at this stage's rate
+        std::vector<float> spectrum;    //latest dB spectrum
+        int samplesSinceLastFFT = 0;
+    };
+
+    //where each output point reads from: a bin range, or an interpolated position if the range is a single bin.
+    struct PointMapping
+    {
+        int stage = 0;
+        int firstBin = 0;   // inclusive
+        int lastBin = 0;    // exclusive
+        float binPosition = 0.f;
+    };
+
+    std::array<Stage, numStages> stages;
+    std::array<PointMapping, numPoints> mapping;
+
+    juce::dsp::FFT forwardFFT{ order };
+    juce::dsp::WindowingFunction<float> window{ fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris };
+    std::vector<float> fftScratch;
+    std::vector<float> decimated, decimatedNext;
+    std::vector<float> mergedFrame;
+
+    double preparedSampleRate = 0.0;
+    int hopSize = 1024;
+
+    //same thread in and out, like FFTDataGenerator: only one pass worth of frames, newest kept.
+    Fifo<std::vector<float>> fftDataFifo{ 16 };
+
+    bool pushIntoCascade(const float* samples, int numSamples, float negativeInfinity);
+    int pushIntoStage(int stageIndex, const float* samples, int numSamples, float negativeInfinity);
+    void analyzeStage(Stage& stage, float negativeInfinity);
+    void mergeStages();
+};
@@ -11,45 +11,245 @@
 #include "PathProducer.h"
 #include <JuceHeader.h>
 
-void PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+void PathProducer::flush()
 {
+    juce::AudioBuffer<float> discardedBuffer;
+    while (leftChannelFifo->getNumCompleteBuffersAvailable() > 0)
+        leftChannelFifo->getAudioBuffer(discardedBuffer);
+
+    std::vector<float> discardedFFTData;
+    while (leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0)
+        leftChannelFFTDataGenerator.getFFTData(discardedFFTData);
+
+    monoBuffer.clear();
+    samplesSinceLastFFT = 0;
+    framesAnalyzed = 0;
+    smoother.reset();
+
+    if (multiResolutionGenerator != nullptr)
+        multiResolutionGenerator->reset();
+
+    fftTrace.clear();
+    peakHoldTrace.clear();
+}
+
+void PathProducer::setMultiResolutionEnabled(bool enabled)
+{
+    if (enabled == (multiResolutionGenerator != nullptr))
+        return;
+
+    if (enabled)
+    {
+        multiResolutionGenerator = std::make_unique<MultiResolutionFFTDataGenerator>();
+        smoother.prepare(MultiResolutionFFTDataGenerator::numPoints, negativeInf);
+    }
+    else
+    {
+        multiResolutionGenerator.reset();
+        monoBuffer.clear();
+        samplesSinceLastFFT = 0;
+        smoother.prepare(leftChannelFFTDataGenerator.getFFTSize() / 2, negativeInf);
+    }
+}
+
+int PathProducer::getHopSize() const
+{
+    //same cadence as the default 8192 point analyzer at this overlap.
+    if (multiResolutionGenerator != nullptr)
+        return juce::jmax(1, (1 << FFTOrder::order8192) / overlap);
+
+    return monoBuffer.getNumSamples() > 0 ? juce::jmax(1, monoBuffer.getNumSamples() / overlap) : 0;
+}
+
+bool PathProducer::process(juce::Rectangle<float> fftBounds, double sampleRate)
+{
+    if (multiResolutionGenerator != nullptr)
+        return processMultiResolution(fftBounds, sampleRate);
+
+    if (leftChannelFFTDataGenerator.installPendingPlan())
+    {
+        monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize(), false, true, true);
+        monoBuffer.clear();
+        samplesSinceLastFFT = 0;
+        smoother.prepare(leftChannelFFTDataGenerator.getFFTSize() / 2, negativeInf);
+    }
+
     juce::AudioBuffer<float> tempIncomingBuffer;
+
+    if (monoBuffer.getNumSamples() == 0)
+    {
+        //the first plan is still being built, nothing to analyze with yet.
+        while (leftChannelFifo->getNumCompleteBuffersAvailable() > 0)
+            leftChannelFifo->getAudioBuffer(tempIncomingBuffer);
+
+        return false;
+    }
+
+    const auto hopSize = getHopSize();
+    const auto framesBefore = framesAnalyzed;
+
+    //the overlap may have gone up since the last call.
+    samplesSinceLastFFT = juce::jmin(samplesSinceLastFFT, hopSize - 1);
+
     while (leftChannelFifo->getNumCompleteBuffersAvailable() > 0)
     {
         if (leftChannelFifo->getAudioBuffer(tempIncomingBuffer))
         {
-            auto size = tempIncomingBuffer.getNumSamples();
+            auto* incoming = tempIncomingBuffer.getReadPointer(0);
+            auto remaining = tempIncomingBuffer.getNumSamples();
 
-            jassert(size <= monoBuffer.getNumSamples());
-            size = juce::jmin(size, monoBuffer.getNumSamples());
+            //fed up to one hop at a time, so a block spanning several hops gets a window for each of them.
+            while (remaining > 0)
+            {
+                auto size = juce::jmin(remaining, hopSize - samplesSinceLastFFT);
+                appendToMonoBuffer(incoming, size);
 
-            auto writePointer = monoBuffer.getWritePointer(0, 0);
-            auto readPointer = monoBuffer.getReadPointer(0, size);
+                incoming += size;
+                remaining -= size;
+                samplesSinceLastFFT += size;
 
-            std::copy(readPointer, readPointer + (monoBuffer.getNumSamples() - size), writePointer);
-
-            juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - size),
-                tempIncomingBuffer.getReadPointer(0, 0),
-                size);
-
-            leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negativeInf);
+                if (samplesSinceLastFFT >= hopSize)
+                {
+                    leftChannelFFTDataGenerator.produceFFTDataForRendering(monoBuffer, negativeInf);
+                    samplesSinceLastFFT -= hopSize;
+                    ++framesAnalyzed;
+                }
+            }
         }
     }
 
     const auto fftSize = leftChannelFFTDataGenerator.getFFTSize();
     const auto binWidth = sampleRate / double(fftSize);
+    const auto numColumns = juce::jmax(1, (int)std::floor(fftBounds.getWidth()));
+    auto samplesBeforeFrame = getSamplesBeforeFirstFrame(framesAnalyzed - framesBefore,
+        leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks(),
+        hopSize);
 
+    //every frame goes through the smoother, but only the latest state becomes a path.
+    bool hasNewFrame = false;
     while (leftChannelFFTDataGenerator.getNumAvailableFFTDataBlocks() > 0)
     {
-        std::vector<float> fftData;
         if (leftChannelFFTDataGenerator.getFFTData(fftData))
         {
-            pathProducer.generatePath(fftData, fftBounds, fftSize, binWidth, negativeInf);
+            smoother.process(fftData.data(), fftSize / 2, toSeconds(samplesBeforeFrame, sampleRate));
+            samplesBeforeFrame = hopSize;
+            hasNewFrame = true;
+
+            if (spectrogram != nullptr)
+            {
+                pathProducer.generateColumnLevels(fftData, numColumns, fftSize, binWidth, spectrogramLine);
+                spectrogram->pushLine(spectrogramLine);
+            }
+        }
+    }
+
+    if (hasNewFrame)
+    {
+        pathProducer.generatePath(smoother.getAveraged(), fftBounds, fftSize, binWidth, negativeInf);
+
+        if (showPeakHold)
+            peakPathProducer.generatePath(smoother.getPeaks(), fftBounds, fftSize, binWidth, negativeInf);
+    }
+
+    pullPaths();
+    return hasNewFrame;
+}
+
+int PathProducer::getSamplesBeforeFirstFrame(int framesMade, int framesQueued, int hopSize)
+{
+    //frames are made one per hop, but the queue only keeps the newest few. the first one
+    //pulled also covers the hops of any that were dropped before it.
+    auto framesDropped = juce::jmax(0, framesMade - framesQueued);
+    return (framesDropped + 1) * hopSize;
+}
+
+float PathProducer::toSeconds(int numSamples, double sampleRate)
+{
+    return sampleRate > 0.0 ? float(numSamples / sampleRate) : 0.f;
+}
+
+void PathProducer::appendToMonoBuffer(const float* samples, int numSamples)
+{
+    //never more than a hop, which is never more than the window.
+    jassert(numSamples <= monoBuffer.getNumSamples());
+
+    if (auto samplesToKeep = monoBuffer.getNumSamples() - numSamples; samplesToKeep > 0)
+    {
+        auto writePointer = monoBuffer.getWritePointer(0, 0);
+        auto readPointer = monoBuffer.getReadPointer(0, numSamples);
+
+        std::copy(readPointer, readPointer + samplesToKeep, writePointer);
+    }
+
+    juce::FloatVectorOperations::copy(monoBuffer.getWritePointer(0, monoBuffer.getNumSamples() - numSamples),
+        samples,
+        numSamples);
+}
+
+bool PathProducer::processMultiResolution(juce::Rectangle<float> fftBounds, double sampleRate)
+{
+    auto& generator = *multiResolutionGenerator;
+
+    const auto hopSize = getHopSize();
+    generator.prepare(sampleRate);
+    generator.setHopSize(hopSize);
+
+    const auto framesBefore = framesAnalyzed;
+
+    juce::AudioBuffer<float> tempIncomingBuffer;
+    while (leftChannelFifo->getNumCompleteBuffersAvailable() > 0)
+    {
+        if (leftChannelFifo->getAudioBuffer(tempIncomingBuffer))
+        {
+            framesAnalyzed += generator.pushSamples(tempIncomingBuffer.getReadPointer(0),
+                tempIncomingBuffer.getNumSamples(),
+                negativeInf);
+        }
+    }
+
+    const auto numColumns = juce::jmax(1, (int)std::floor(fftBounds.getWidth()));
+    auto samplesBeforeFrame = getSamplesBeforeFirstFrame(framesAnalyzed - framesBefore,
+        generator.getNumAvailableFFTDataBlocks(),
+        hopSize);
+
+    bool hasNewFrame = false;
+    while (generator.getNumAvailableFFTDataBlocks() > 0)
+    {
+        if (generator.getFFTData(fftData))
+        {
+            smoother.process(fftData.data(), MultiResolutionFFTDataGenerator::numPoints, toSeconds(samplesBeforeFrame, sampleRate));
+            samplesBeforeFrame = hopSize;
+            hasNewFrame = true;
+
+            if (spectrogram != nullptr)
+            {
+                pathProducer.generateLogColumnLevels(fftData, numColumns, spectrogramLine);
+                spectrogram->pushLine(spectrogramLine);
+            }
         }
     }
 
+    if (hasNewFrame)
+    {
+        pathProducer.generateLogPath(smoother.getAveraged(), fftBounds, negativeInf);
+
+        if (showPeakHold)
+            peakPathProducer.generateLogPath(smoother.getPeaks(), fftBounds, negativeInf);
+    }
+
+    pullPaths();
+    return hasNewFrame;
+}
+
+void PathProducer::pullPaths()
+{
     while (pathProducer.getNumPathsAvailable() > 0)
     {
-        pathProducer.getPath(leftChannelFFTPath);
+        pathProducer.getPath(fftTrace);
+    }
+
+    while (peakPathProducer.getNumPathsAvailable() > 0)
+    {
+        peakPathProducer.getPath(peakHoldTrace);
     }
 }
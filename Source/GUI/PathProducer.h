@@ -13,29 +13,79 @@
 #include "../GUI/FFTDataGenerator.h"
 #include "../GUI/Utilities.h"
 #include "../GUI/AnalyzerPathGenerator.h"
+#include "../GUI/SpectrumSmoother.h"
+#include "../GUI/MultiResolutionFFTDataGenerator.h"
+#include "../GUI/SpectrumTraceRenderer.h"
+#include "../GUI/Spectrogram.h"
 #include "../PluginProcessor.h"
 
 struct PathProducer
 {
-    PathProducer(SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>& scsf) :
+    PathProducer(SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>& scsf, FFTOrder order = FFTOrder::order8192) :
         leftChannelFifo(&scsf)
     {
-        leftChannelFFTDataGenerator.changeOrder(FFTOrder::order8192);
-        monoBuffer.setSize(1, leftChannelFFTDataGenerator.getFFTSize());
+        leftChannelFFTDataGenerator.changeOrder(order);
     }
-    void process(juce::Rectangle<float> fftBounds, double sampleRate);
-    juce::Path getPath() { return leftChannelFFTPath; }
+    //returns true if the traces changed.
+    bool process(juce::Rectangle<float> fftBounds, double sampleRate);
+    const SpectrumTrace& getTrace() const { return fftTrace; }
+    const SpectrumTrace& getPeakHoldTrace() const { return peakHoldTrace; }
+
+    //drops queued audio, fft data and history so a resumed analyzer starts clean.
+    void flush();
 
     void updateNEgativeInfinity(float nf) { negativeInf = nf; }
+
+    //the new FFT is built in the background and picked up by a later process() call.
+    void changeOrder(FFTOrder newOrder) { leftChannelFFTDataGenerator.changeOrder(newOrder); }
+
+    //swaps the single FFT for the octave cascade in MultiResolutionFFTDataGenerator.
+    void setMultiResolutionEnabled(bool enabled);
+
+    //an FFT is run every 'fftSize / overlapFactor' samples.
+    void setOverlap(int overlapFactor) { overlap = juce::jmax(1, overlapFactor); }
+    //0 until the first FFT plan is installed.
+    int getHopSize() const;
+    //one per hop of audio pulled since the last flush().
+    int getNumFramesAnalyzed() const { return framesAnalyzed; }
+
+    //0 shows the raw frames.
+    void setAveragingTime(float seconds) { smoother.setTimeConstant(seconds); }
+    //every FFT frame is also written to 'spectrogramToFeed' as one line, nullptr stops it.
+    void setSpectrogram(Spectrogram* spectrogramToFeed) { spectrogram = spectrogramToFeed; }
+
+    void setPeakHoldEnabled(bool enabled)
+    {
+        showPeakHold = enabled;
+        if (!enabled)
+            peakHoldTrace.clear();
+    }
 private:
     SingleChannelSampleFifo<SimpleMBCompAudioProcessor::BlockType>* leftChannelFifo;
 
     juce::AudioBuffer<float> monoBuffer;
+    int samplesSinceLastFFT = 0;
+    int overlap = 8;
+    int framesAnalyzed = 0;
 
     FFTDataGenerator<std::vector<float>> leftChannelFFTDataGenerator;
+    std::unique_ptr<MultiResolutionFFTDataGenerator> multiResolutionGenerator;
+    std::vector<float> fftData;
+
+    SpectrumSmoother smoother;
 
-    AnalyzerPathGenerator<juce::Path> pathProducer;
+    Spectrogram* spectrogram = nullptr;
+    std::vector<float> spectrogramLine;
+    bool showPeakHold = false;
 
-    juce::Path leftChannelFFTPath;
+    AnalyzerPathGenerator<SpectrumTrace> pathProducer, peakPathProducer;
+
+    SpectrumTrace fftTrace, peakHoldTrace;
     float negativeInf{ -48.f };
+
+    void appendToMonoBuffer(const float* samples, int numSamples);
+    static int getSamplesBeforeFirstFrame(int framesMade, int framesQueued, int hopSize);
+    static float toSeconds(int numSamples, double sampleRate);
+    bool processMultiResolution(juce::Rectangle<float> fftBounds, double sampleRate);
+    void pullPaths();
 };
@@ -10,31 +10,65 @@
 
 #include "RotarySliderWithLabels.h"
 #include "Utilities.h"
+#include "LookAnFeel.h"
+
+namespace
+{
+    const auto startAngle = juce::degreesToRadians(180.f + 45.f);
+    const auto endAngle = juce::degreesToRadians(180.f - 45.f + 360.f);
+}
 
 void RotarySliderWithLabels::paint(juce::Graphics& g)
 {
     using namespace juce;
 
-    auto startAng = degreesToRadians(180.f + 45.f);
-    auto endAng = degreesToRadians(180.f - 45.f + 360.f);
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (!backgroundImage.isValid() || scale != backgroundScale)
+        renderBackgroundImage(scale);
+
+    g.drawImage(backgroundImage, getLocalBounds().toFloat());
 
     auto range = getRange();
     auto sliderBounds = getSliderBouds();
 
-    auto bounds = getLocalBounds();
-
-    g.setColour(Colours::white);
-    g.drawFittedText(getName(), bounds.removeFromTop(getTextBoxHeight() + 2), Justification::centredBottom, 1);
-
     getLookAndFeel().drawRotarySlider(g,
         sliderBounds.getX(),
         sliderBounds.getY(),
         sliderBounds.getWidth(),
         sliderBounds.getHeight(),
         jmap(getValue(), range.getStart(), range.getEnd(), 0.0, 1.0),
-        startAng,
-        endAng,
+        startAngle,
+        endAngle,
         *this);
+}
+
+void RotarySliderWithLabels::renderBackgroundImage(float scale)
+{
+    using namespace juce;
+    backgroundScale = scale;
+
+    auto width = roundToInt(getWidth() * scale);
+    auto height = roundToInt(getHeight() * scale);
+    if (width <= 0 || height <= 0)
+    {
+        backgroundImage = Image();
+        return;
+    }
+
+    backgroundImage = Image(Image::ARGB, width, height, true);
+
+    Graphics g(backgroundImage);
+    g.addTransform(AffineTransform::scale(scale));
+
+    auto sliderBounds = getSliderBouds();
+    auto bounds = getLocalBounds();
+
+    g.setColour(Colours::white);
+    g.drawFittedText(getName(), bounds.removeFromTop(getTextBoxHeight() + 2), Justification::centredBottom, 1);
+
+    //with any other LookAndFeel drawRotarySlider() draws the whole knob itself.
+    if (auto* lnf = dynamic_cast<LookAndFeel*>(&getLookAndFeel()))
+        lnf->drawRotarySliderBackground(g, sliderBounds.toFloat(), *this);
 
     auto center = sliderBounds.toFloat().getCentre();
     auto radius = sliderBounds.getWidth() * 0.5f;
@@ -48,7 +82,7 @@ void RotarySliderWithLabels::paint(juce::Graphics& g)
         auto pos = labels[i].pos;
         jassert(0.f <= pos);
         jassert(pos <= 1.f);
-        auto angle = jmap(pos, 0.f, 1.f, startAng, endAng);
+        auto angle = jmap(pos, 0.f, 1.f, startAngle, endAngle);
 
         auto c = center.getPointOnCircumference(radius + getTextHeight() * 0.5f + 1, angle);
 
@@ -62,6 +96,64 @@ void RotarySliderWithLabels::paint(juce::Graphics& g)
     }
 }
 
+void RotarySliderWithLabels::resized()
+{
+    juce::Slider::resized();
+
+    backgroundImage = juce::Image();
+    updatePointerPath();
+}
+
+void RotarySliderWithLabels::enablementChanged()
+{
+    juce::Slider::enablementChanged();
+    backgroundImage = juce::Image();
+}
+
+void RotarySliderWithLabels::lookAndFeelChanged()
+{
+    juce::Slider::lookAndFeelChanged();
+    backgroundImage = juce::Image();
+}
+
+void RotarySliderWithLabels::updatePointerPath()
+{
+    auto bounds = getSliderBouds().toFloat();
+    auto center = bounds.getCentre();
+
+    juce::Rectangle<float> r;
+    r.setLeft(center.getX() - 1);
+    r.setRight(center.getX() + 1);
+    r.setTop(bounds.getY());
+    r.setBottom(center.getY() - getTextHeight() * 2.5);
+
+    pointerPath.clear();
+    pointerPath.addRoundedRectangle(r, 1.f);
+}
+
+const RotarySliderWithLabels::ValueText& RotarySliderWithLabels::getValueText()
+{
+    auto value = getValue();
+    if (!valueTextIsStale && value == valueTextValue)
+        return valueText;
+
+    valueTextIsStale = false;
+    valueTextValue = value;
+
+    juce::Font font((float)getTextHeight());
+    valueText.text = getDisplayString();
+
+    auto width = std::ceil(font.getStringWidthFloat(valueText.text));
+    auto height = (float)getTextHeight() + 2.f;
+
+    valueText.glyphs.clear();
+    valueText.glyphs.addFittedText(font, valueText.text,
+        -width * 0.5f, -height * 0.5f, width, height,
+        juce::Justification::centred, 1);
+
+    return valueText;
+}
+
 juce::Rectangle<int> RotarySliderWithLabels::getSliderBouds() const
 {
     auto bounds = getLocalBounds();
@@ -113,6 +205,10 @@ juce::String RotarySliderWithLabels::getDisplayString() const
 void RotarySliderWithLabels::changeParam(juce::RangedAudioParameter* p)
 {
     param = p;
+
+    //the labels and the value text belong to the new parameter.
+    valueTextIsStale = true;
+    backgroundImage = juce::Image();
     repaint();
 }
 //==============================================================================
@@ -29,18 +29,51 @@ struct RotarySliderWithLabels : juce::Slider
         juce::String label;
     };
 
+    //edit these before the first paint, or follow up with changeParam() so the cached layer is redrawn.
     juce::Array<LabelPos> labels;
 
     void paint(juce::Graphics& g) override;
+    void resized() override;
+    void enablementChanged() override;
+    void lookAndFeelChanged() override;
+
     juce::Rectangle<int> getSliderBouds() const;
     int getTextHeight() const { return 13; }
     virtual juce::String getDisplayString() const;
 
     void changeParam(juce::RangedAudioParameter* p);
 
+    //the pointer at 12 o'clock, rotated into place when drawn.
+    const juce::Path& getPointerPath() const { return pointerPath; }
+
+    struct ValueText
+    {
+        juce::String text;
+        juce::GlyphArrangement glyphs; //laid out centred on (0, 0)
+    };
+
+    //getDisplayString(), only remade and re-measured when the value or parameter changes.
+    const ValueText& getValueText();
+
 protected:
     juce::RangedAudioParameter* param;
     juce::String suffix;
+private:
+    /*
+     title, knob body and range labels only change with the size, the enablement
+     or the parameter, so they're drawn once into an image. paint() blits it and
+     draws the pointer and value text on top.
+     */
+    juce::Image backgroundImage;
+    float backgroundScale = 0.f;
+    void renderBackgroundImage(float scale);
+
+    juce::Path pointerPath;
+    void updatePointerPath();
+
+    ValueText valueText;
+    double valueTextValue = 0.0;
+    bool valueTextIsStale = true;
 };
 
 struct RatioSlider : RotarySliderWithLabels
@@ -0,0 +1,134 @@
+/*
+  ==============================================================================
+
+    Spectrogram.cpp
+    Created: 19 Oct 2026 5:40:02pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "Spectrogram.h"
+
+Spectrogram::Spectrogram()
+{
+    juce::ColourGradient gradient;
+    gradient.addColour(0.0, juce::Colours::black);
+    gradient.addColour(0.3, juce::Colour(0xff2a0a5e));
+    gradient.addColour(0.55, juce::Colour(0xffa3206b));
+    gradient.addColour(0.8, juce::Colour(0xfff36e21));
+    gradient.addColour(1.0, juce::Colour(0xfffcf5a0));
+
+    for (size_t i = 0; i < colourTable.size(); ++i)
+    {
+        auto colour = gradient.getColourAtPosition((double)i / (double)(colourTable.size() - 1));
+        colourTable[i].set(colour.getPixelARGB());
+    }
+}
+
+void Spectrogram::pushLine(const std::vector<float>& levels)
+{
+    const auto width = (int)levels.size();
+    if (width == 0)
+        return;
+
+    if (!image.isValid() || image.getWidth() != width)
+    {
+        //a software image really is RGB, so the rows can be written as PixelRGB below. a native
+        //image is free to pick another format.
+        image = juce::Image(juce::Image::RGB, width, numLines, true, juce::SoftwareImageType());
+        newestLine = 0;
+    }
+
+    newestLine = (newestLine + numLines - 1) % numLines;
+
+    constexpr auto lastEntry = (float)(std::tuple_size<decltype(colourTable)>::value - 1);
+    constexpr auto entriesPerDecibel = lastEntry / (ceilingDecibels - floorDecibels);
+
+    juce::Image::BitmapData line(image, 0, newestLine, width, 1, juce::Image::BitmapData::writeOnly);
+    jassert(line.pixelFormat == juce::Image::RGB);
+
+    for (int x = 0; x < width; ++x)
+    {
+        auto index = juce::jlimit(0.f, lastEntry, (levels[x] - floorDecibels) * entriesPerDecibel);
+        if (std::isnan(index))
+            index = 0.f;
+
+        *reinterpret_cast<juce::PixelRGB*>(line.getPixelPointer(x, 0)) = colourTable[(size_t)index];
+    }
+
+    ++numLinesWritten;
+}
+
+void Spectrogram::clear()
+{
+    if (image.isValid())
+        image.clear(image.getBounds());
+
+    ++numLinesWritten;
+}
+
+void Spectrogram::draw(juce::Graphics& g, juce::Rectangle<int> area) const
+{
+    if (!image.isValid())
+        return;
+
+    //newest line at the top: the rows from 'newestLine' down, then the ones that wrapped.
+    const auto lineHeight = (float)area.getHeight() / (float)numLines;
+    const auto newerLines = numLines - newestLine;
+    const auto splitY = area.getY() + juce::roundToInt(newerLines * lineHeight);
+
+    g.drawImage(image,
+        area.getX(), area.getY(), image.getWidth(), splitY - area.getY(),
+        0, newestLine, image.getWidth(), newerLines);
+
+    if (newestLine > 0)
+    {
+        g.drawImage(image,
+            area.getX(), splitY, image.getWidth(), area.getBottom() - splitY,
+            0, 0, image.getWidth(), newestLine);
+    }
+}
+//==============================================================================
+SpectrogramView::SpectrogramView(const Spectrogram& spectrogramToShow) :
+    spectrogram(spectrogramToShow)
+{
+    setOpaque(true);
+}
+
+void SpectrogramView::paint(juce::Graphics& g)
+{
+    drawModuleBackground(g, getLocalBounds());
+
+    g.setColour(juce::Colours::black);
+    auto area = getDisplayArea();
+    g.fillRect(area);
+
+    juce::Graphics::ScopedSaveState sss(g);
+    g.reduceClipRegion(area);
+    spectrogram.draw(g, area);
+}
+
+bool SpectrogramView::updateFrame()
+{
+    if (spectrogram.getNumLinesWritten() == linesShown)
+        return false;
+
+    linesShown = spectrogram.getNumLinesWritten();
+
+    if (isShowing())
+        repaint(getDisplayArea());
+
+    return true;
+}
+
+juce::Rectangle<int> SpectrogramView::getDisplayArea() const
+{
+    //the same insets as SpectrumAnalyzer's analysis area, so column x lines up with the trace.
+    auto bounds = getLocalBounds().reduced(3);
+    bounds.removeFromLeft(20);
+    bounds.removeFromRight(20);
+    bounds.removeFromTop(4);
+    bounds.removeFromBottom(4);
+    return bounds;
+}
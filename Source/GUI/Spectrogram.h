@@ -0,0 +1,63 @@
+/*
+  ==============================================================================
+
+    Spectrogram.h
+    Created: 19 Oct 2026 5:40:02pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include "FrameScheduler.h"
+#include "Utilities.h"
+
+/*
+ a waterfall: frequency runs left to right on the same columns as the line analyzer,
+ time runs top (newest) to bottom.
+
+ 'image' is a ring of lines. each FFT frame writes one line over the oldest one and
+ moves 'newestLine', nothing is ever shifted; draw() blits the ring in two pieces.
+ */
+struct Spectrogram
+{
+    Spectrogram();
+
+    //column levels in dB, one per pixel column. the image is rebuilt if the width changes.
+    void pushLine(const std::vector<float>& levels);
+    void clear();
+
+    void draw(juce::Graphics& g, juce::Rectangle<int> area) const;
+
+    //bumped on every pushLine() / clear(), so a view can tell if it needs to repaint.
+    int getNumLinesWritten() const { return numLinesWritten; }
+
+    static constexpr int numLines = 128;
+    static constexpr float floorDecibels = NEGATIVE_INFINITY;
+    static constexpr float ceilingDecibels = 0.f;
+private:
+    juce::Image image;
+    int newestLine = 0;
+    int numLinesWritten = 0;
+
+    std::array<juce::PixelRGB, 256> colourTable;
+};
+
+/*
+ shows a Spectrogram with its columns lined up with SpectrumAnalyzer's analysis area.
+ */
+struct SpectrogramView : juce::Component,
+    FrameScheduler::Client
+{
+    SpectrogramView(const Spectrogram& spectrogramToShow);
+
+    void paint(juce::Graphics& g) override;
+    bool updateFrame() override;
+private:
+    const Spectrogram& spectrogram;
+    int linesShown = 0;
+
+    juce::Rectangle<int> getDisplayArea() const;
+};
@@ -12,22 +12,15 @@
 #include <JuceHeader.h>
 #include "../GUI/Utilities.h"
 #include "../DSP/Params.h"
+#include "LookAnFeel.h"
 
 SpectrumAnalyzer::SpectrumAnalyzer(SimpleMBCompAudioProcessor& p) :
-    audioProcessor(p),
-    leftPathProducer(audioProcessor.leftChannelFifo),
-    rightPathProducer(audioProcessor.rightChannelFifo)
+    audioProcessor(p)
 {
-    const auto& params = audioProcessor.getParameters();
-    for (auto param : params)
-    {
-        param->addListener(this);
-    }
     using namespace Params;
-    const auto& paramNames = GetParams();
 
-    auto floatHelper = [&apvts = audioProcessor.apvts , &paramNames](auto& param, const auto& paramName)
-        { param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(paramNames.at(paramName))); };
+    auto floatHelper = [&registry = audioProcessor.paramRegistry](auto& param, const auto& paramName)
+        { param = registry.get<juce::AudioParameterFloat>(paramName); };
 
     floatHelper(lowMidXoverParam, Names::Low_Mid_Crossover_Freq);
     floatHelper(midHighXoverParam, Names::Mid_High_Crossover_Freq);
@@ -36,17 +29,195 @@ SpectrumAnalyzer::SpectrumAnalyzer(SimpleMBCompAudioProcessor& p) :
     floatHelper(midThresholdParam, Names::Threshold_Mid_Band);
     floatHelper(highThresholdParam, Names::Threshold_High_Band);
 
+    //only what the overlay draws: every other parameter would just be listener fan-out.
+    for (auto* param : getOverlayParams())
+        param->addListener(this);
 
-    startTimerHz(60);
+    //only recorded here, the producers are built on the first frame the analyzer is showing.
+    setTapEnabled(InputTap, true);
 }
 
 SpectrumAnalyzer::~SpectrumAnalyzer()
 {
-    const auto& params = audioProcessor.getParameters();
-    for (auto param : params)
-    {
+    for (int tap = 0; tap < NumAnalyzerTaps; ++tap)
+        destroyTapProducers(static_cast<AnalyzerTap>(tap));
+
+    for (auto* param : getOverlayParams())
         param->removeListener(this);
+}
+
+void SpectrumAnalyzer::toggleAnalysisEnablement(bool enabled)
+{
+    if (enabled == shouldShowFFTAnalysis)
+        return;
+
+    shouldShowFFTAnalysis = enabled;
+
+    for (int tap = 0; tap < NumAnalyzerTaps; ++tap)
+    {
+        if (tapProducers[tap] == nullptr)
+            continue;
+
+        if (enabled)
+            subscribeTap(static_cast<AnalyzerTap>(tap));
+        else
+            audioProcessor.removeAnalyzerSubscriber(static_cast<AnalyzerTap>(tap));
+    }
+
+    repaint(getAnalysisArea(getLocalBounds().reduced(3)));
+}
+
+void SpectrumAnalyzer::setTapEnabled(AnalyzerTap tap, bool enabled)
+{
+    if (enabled == isTapEnabled(tap))
+        return;
+
+    enabledTaps[tap] = enabled;
+
+    //allocateResources() picks this up when the analyzer is first shown.
+    if (!resourcesAllocated)
+        return;
+
+    if (enabled)
+        createTapProducers(tap);
+    else
+        destroyTapProducers(tap);
+
+    updateSpectrogramSource();
+}
+
+void SpectrumAnalyzer::allocateResources()
+{
+    resourcesAllocated = true;
+
+    for (int tap = 0; tap < NumAnalyzerTaps; ++tap)
+    {
+        if (enabledTaps[tap])
+            createTapProducers(static_cast<AnalyzerTap>(tap));
+    }
+
+    updateSpectrogramSource();
+}
+
+void SpectrumAnalyzer::releaseResources()
+{
+    resourcesAllocated = false;
+
+    for (int tap = 0; tap < NumAnalyzerTaps; ++tap)
+        destroyTapProducers(static_cast<AnalyzerTap>(tap));
+
+    updateSpectrogramSource();
+}
+
+void SpectrumAnalyzer::createTapProducers(AnalyzerTap tap)
+{
+    auto producers = std::make_unique<TapPathProducers>(audioProcessor.analyzerTaps[tap], settings.order);
+
+    for (auto* producer : { &producers->left, &producers->right })
+    {
+        producer->setMultiResolutionEnabled(settings.multiResolution);
+        producer->setOverlap(settings.overlap);
+        producer->setAveragingTime(settings.averagingTime);
+        producer->setPeakHoldEnabled(settings.peakHold);
+        producer->updateNEgativeInfinity(negativeInfinity);
+    }
+
+    tapProducers[tap] = std::move(producers);
+
+    if (shouldShowFFTAnalysis)
+        subscribeTap(tap);
+}
+
+void SpectrumAnalyzer::destroyTapProducers(AnalyzerTap tap)
+{
+    if (tapProducers[tap] == nullptr)
+        return;
+
+    if (shouldShowFFTAnalysis)
+        audioProcessor.removeAnalyzerSubscriber(tap);
+
+    tapProducers[tap].reset();
+    repaint(getAnalysisArea(getLocalBounds().reduced(3)));
+}
+
+void SpectrumAnalyzer::setSpectrogramEnabled(bool enabled)
+{
+    showSpectrogram = enabled;
+    updateSpectrogramSource();
+}
+
+void SpectrumAnalyzer::updateSpectrogramSource()
+{
+    PathProducer* newSource = nullptr;
+
+    if (showSpectrogram)
+    {
+        auto firstTap = std::find_if(tapProducers.begin(), tapProducers.end(), [](const auto& tap) { return tap != nullptr; });
+        if (firstTap != tapProducers.end())
+            newSource = &(*firstTap)->left;
     }
+
+    if (newSource == spectrogramSource)
+        return;
+
+    //the old source may already be gone, so don't touch it.
+    if (newSource != nullptr)
+        newSource->setSpectrogram(&spectrogram);
+
+    forEachPathProducer([newSource](auto& producer)
+        {
+            if (&producer != newSource)
+                producer.setSpectrogram(nullptr);
+        });
+
+    spectrogramSource = newSource;
+
+    //history from a different source would be misleading.
+    spectrogram.clear();
+}
+
+void SpectrumAnalyzer::subscribeTap(AnalyzerTap tap)
+{
+    //the fifos may still hold audio from a previous editor or an earlier subscription.
+    tapProducers[tap]->left.flush();
+    tapProducers[tap]->right.flush();
+    audioProcessor.addAnalyzerSubscriber(tap);
+}
+
+void SpectrumAnalyzer::setFFTOrder(FFTOrder newOrder)
+{
+    settings.order = newOrder;
+    forEachPathProducer([newOrder](auto& producer) { producer.changeOrder(newOrder); });
+}
+
+void SpectrumAnalyzer::setMultiResolutionEnabled(bool enabled)
+{
+    settings.multiResolution = enabled;
+    forEachPathProducer([enabled](auto& producer) { producer.setMultiResolutionEnabled(enabled); });
+}
+
+void SpectrumAnalyzer::setOverlap(int overlapFactor)
+{
+    settings.overlap = overlapFactor;
+    forEachPathProducer([overlapFactor](auto& producer) { producer.setOverlap(overlapFactor); });
+}
+
+void SpectrumAnalyzer::setAveragingTime(float seconds)
+{
+    settings.averagingTime = seconds;
+    forEachPathProducer([seconds](auto& producer) { producer.setAveragingTime(seconds); });
+}
+
+void SpectrumAnalyzer::setPeakHoldEnabled(bool enabled)
+{
+    settings.peakHold = enabled;
+    forEachPathProducer([enabled](auto& producer) { producer.setPeakHoldEnabled(enabled); });
+}
+
+void SpectrumAnalyzer::setTraceAntiAliasing(bool shouldAntiAlias)
+{
+    traceRenderer.setAntiAliased(shouldAntiAlias);
+    repaint(getAnalysisArea(getLocalBounds().reduced(3)));
 }
 
 void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds)
@@ -54,31 +225,41 @@ void SpectrumAnalyzer::drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> b
     using namespace juce;
     auto responseArea = getAnalysisArea(bounds);
 
-    Graphics::ScopedSaveState sss(g);
-    g.reduceClipRegion(responseArea);
+    //trace x is already relative to the response area, y is relative to the component.
+    traceRenderer.begin(responseArea.getWidth(),
+        responseArea.getHeight(),
+        g.getInternalContext().getPhysicalPixelScaleFactor());
+
+    const auto yOffset = -(float)responseArea.getY();
 
-    auto leftChannelFFTPath = leftPathProducer.getPath();
-    leftChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0)); // responseArea.getY()));
+    for (int tap = 0; tap < NumAnalyzerTaps; ++tap)
+    {
+        if (tapProducers[tap] == nullptr)
+            continue;
 
-    g.setColour(juce::Colours::forestgreen); // g.setColour(Colour(97u, 18u, 167u))-
-    g.strokePath(leftChannelFFTPath, PathStrokeType(1.f));
+        auto tapColour = ColorScheme::getAnalyzerTapColor(tap);
 
-    auto rightChannelFFTPath = rightPathProducer.getPath();
-    rightChannelFFTPath.applyTransform(AffineTransform().translation(responseArea.getX(), 0)); // responseArea.getY()));
+        for (auto* producer : { &tapProducers[tap]->left, &tapProducers[tap]->right })
+        {
+            traceRenderer.drawTrace(producer->getTrace(), yOffset, tapColour);
+            traceRenderer.drawTrace(producer->getPeakHoldTrace(), yOffset, tapColour.withAlpha(0.5f));
+        }
+    }
 
-    g.setColour(juce::Colours::forestgreen); //g.setColour(Colour(215u, 201u, 134u));
-    g.strokePath(rightChannelFFTPath, PathStrokeType(1.f));
+    traceRenderer.draw(g, responseArea);
 }
 
 void SpectrumAnalyzer::paint(juce::Graphics& g)
 {
     using namespace juce;
-    // (Our component is opaque, so we must completely fill the background with a solid colour)
-    g.fillAll(juce::Colours::pink); //lightgrey
+    auto scale = g.getInternalContext().getPhysicalPixelScaleFactor();
+    if (!backgroundImage.isValid() || scale != backgroundScale)
+        renderBackgroundImage(scale);
 
-    auto bounds = drawModuleBackground(g, getLocalBounds());
+    g.drawImage(backgroundImage, getLocalBounds().toFloat());
 
-    drawBackgroundGrid(g, bounds);
+    //same inset drawModuleBackground() used for the cached layer.
+    auto bounds = getLocalBounds().reduced(3);
 
     if (shouldShowFFTAnalysis)
     {
@@ -86,6 +267,33 @@ void SpectrumAnalyzer::paint(juce::Graphics& g)
     }
 
     drawCrossovers(g, bounds);
+    drawMeasuredResponse(g, bounds);
+}
+
+void SpectrumAnalyzer::renderBackgroundImage(float scale)
+{
+    using namespace juce;
+    backgroundScale = scale;
+
+    auto width = roundToInt(getWidth() * scale);
+    auto height = roundToInt(getHeight() * scale);
+    if (width <= 0 || height <= 0)
+    {
+        backgroundImage = Image();
+        return;
+    }
+
+    backgroundImage = Image(Image::RGB, width, height, true);
+
+    Graphics g(backgroundImage);
+    g.addTransform(AffineTransform::scale(scale));
+
+    // (Our component is opaque, so we must completely fill the background with a solid colour)
+    g.fillAll(juce::Colours::pink); //lightgrey
+
+    auto bounds = drawModuleBackground(g, getLocalBounds());
+
+    drawBackgroundGrid(g, bounds);
     drawTextLabels(g, bounds);
 }
 
@@ -99,19 +307,13 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bo
     const auto left = bounds.getX();
     const auto right = bounds.getRight();
 
-    auto mapX = [left = bounds.getX(), width = bounds.getWidth()](float frequency)
-        {
-            auto normX = juce::mapFromLog10(frequency, MIN_FREQUENCY, MAX_FREQUENCY);
-            return left + width * normX;
-        };
-
+    const auto lowMidX = overlay.lowMidX;
+    const auto midHighX = overlay.midHighX;
 
     auto xColour = juce::Colours::darkslategrey;
-    auto lowMidX = mapX(lowMidXoverParam->get());
     g.setColour(xColour);
     //g.drawVerticalLine(lowMidX, top, bottom);
     g.fillRect(int(lowMidX), int(top), 2, int(bottom - top));
-    auto midHighX = mapX(midHighXoverParam->get());
     //g.drawVerticalLine(midHighX, top, bottom);
     g.fillRect(int(midHighX), int(top), 2, int(bottom - top));
 
@@ -129,29 +331,71 @@ void SpectrumAnalyzer::drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bo
 
     g.setColour(xColour);
     //g.drawHorizontalLine(mapY(lowThresholdParam->get()), left, lowMidX);
-    g.fillRect(int(left), int(mapY(lowThresholdParam->get())), int(lowMidX-left)+1,2);
+    g.fillRect(int(left), int(overlay.lowThresholdY), int(lowMidX-left)+1,2);
     //g.drawHorizontalLine(mapY(midThresholdParam->get()), lowMidX, midHighX);
-    g.fillRect(int(lowMidX), int(mapY(midThresholdParam->get())), int(midHighX - lowMidX)+1, 2);
+    g.fillRect(int(lowMidX), int(overlay.midThresholdY), int(midHighX - lowMidX)+1, 2);
     //g.drawHorizontalLine(mapY(highThresholdParam->get()), midHighX, right);
-    g.fillRect(int(midHighX), int(mapY(highThresholdParam->get())), int(right - midHighX)+1, 2);
+    g.fillRect(int(midHighX), int(overlay.highThresholdY), int(right - midHighX)+1, 2);
 }
 
-void SpectrumAnalyzer::update(const std::vector<float>& values)
+void SpectrumAnalyzer::updateOverlayGeometry()
 {
-    enum
-    {
-        LowBandIn,
-        LowBandOut,
-        MidBandIn,
-        MidBandOut,
-        HighBandIn,
-        HighBandOut
-    };
-    lowBandGR = values[LowBandOut] - values[LowBandIn];
-    midBandGR = values[MidBandOut] - values[MidBandIn];
-    highBandGR = values[HighBandOut] - values[HighBandIn];
+    using namespace juce;
+    auto bounds = getAnalysisArea(getLocalBounds().reduced(3));
 
-    repaint();
+    auto mapX = [left = bounds.getX(), width = bounds.getWidth()](float frequency)
+        {
+            auto normX = juce::mapFromLog10(frequency, MIN_FREQUENCY, MAX_FREQUENCY);
+            return left + width * normX;
+        };
+
+    auto mapY = [bottom = bounds.getBottom(), top = bounds.getY()](float db)
+        {
+            return jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, (float)bottom, (float)top);
+        };
+
+    overlay.lowMidX = mapX(lowMidXoverParam->get());
+    overlay.midHighX = mapX(midHighXoverParam->get());
+    overlay.lowThresholdY = mapY(lowThresholdParam->get());
+    overlay.midThresholdY = mapY(midThresholdParam->get());
+    overlay.highThresholdY = mapY(highThresholdParam->get());
+}
+
+bool SpectrumAnalyzer::update(const std::array<float, 3>& gainReductiondB)
+{
+    bool changed = false;
+    auto updateBand = [this, &changed](int band, float& gainReduction, float newGainReduction)
+        {
+            //anything smaller doesn't move the overlay by a pixel.
+            if (std::abs(newGainReduction - gainReduction) < 0.01f)
+                return;
+
+            gainReduction = newGainReduction;
+            repaint(getBandArea(band));
+            changed = true;
+        };
+
+    updateBand(0, lowBandGR, gainReductiondB[0]);
+    updateBand(1, midBandGR, gainReductiondB[1]);
+    updateBand(2, highBandGR, gainReductiondB[2]);
+
+    return changed;
+}
+
+juce::Rectangle<int> SpectrumAnalyzer::getBandArea(int band)
+{
+    auto area = getAnalysisArea(getLocalBounds().reduced(3));
+
+    auto lowMidX = int(overlay.lowMidX);
+    auto midHighX = int(overlay.midHighX);
+
+    //a couple of pixels either side for the 2px crossover lines.
+    switch (band)
+    {
+        case 0: return area.withRight(lowMidX + 3);
+        case 1: return area.withLeft(lowMidX - 1).withRight(midHighX + 3);
+        default: return area.withLeft(midHighX - 1);
+    }
 }
 
 std::vector<float> SpectrumAnalyzer::getFrequencies()
@@ -293,6 +537,9 @@ void SpectrumAnalyzer::drawTextLabels(juce::Graphics& g, juce::Rectangle<int> bo
 void SpectrumAnalyzer::resized()
 {
     using namespace juce;
+    backgroundImage = Image();
+    updateOverlayGeometry();
+
     auto bounds = getLocalBounds();
     auto fftBounds = getAnalysisArea(bounds).toFloat();
     auto negInf = jmap(bounds.toFloat().getBottom(),
@@ -300,9 +547,11 @@ void SpectrumAnalyzer::resized()
                         NEGATIVE_INFINITY, 
                         MAX_DECIBELS);
 
+    updateMeasuredResponsePath();
+
     DBG("Neg: " << negInf);
-    leftPathProducer.updateNEgativeInfinity(negInf);
-    rightPathProducer.updateNEgativeInfinity(negInf);
+    negativeInfinity = negInf;
+    forEachPathProducer([negInf](auto& producer) { producer.updateNEgativeInfinity(negInf); });
 
 }
 
@@ -313,8 +562,22 @@ void SpectrumAnalyzer::parameterValueChanged(int parameterIndex, float newValue)
 
 
 
-void SpectrumAnalyzer::timerCallback()
+bool SpectrumAnalyzer::updateFrame()
 {
+    //a host can keep a closed editor around: don't hold FFTs for it while nothing is on screen.
+    if (!isShowing())
+    {
+        if (resourcesAllocated)
+            releaseResources();
+
+        return false;
+    }
+
+    if (!resourcesAllocated)
+        allocateResources();
+
+    bool changed = false;
+
     if (shouldShowFFTAnalysis)
     {
         auto bounds = getLocalBounds();
@@ -322,16 +585,26 @@ void SpectrumAnalyzer::timerCallback()
         fftBounds.setBottom(bounds.getBottom());
         auto sampleRate = audioProcessor.getSampleRate();
 
-        leftPathProducer.process(fftBounds, sampleRate);
-        rightPathProducer.process(fftBounds, sampleRate);
+        forEachPathProducer([fftBounds, sampleRate, &changed](auto& producer)
+            {
+                changed = producer.process(fftBounds, sampleRate) || changed;
+            });
     }
 
     if (parametersChanged.compareAndSetBool(false, true))
     {
-
+        updateOverlayGeometry();
+        changed = true;
     }
 
-    repaint();
+    if (waitingForMeasurement)
+        changed = updateMeasurement() || changed;
+
+    //only the analysis area is dynamic, the rest comes from backgroundImage.
+    if (changed)
+        repaint(getAnalysisArea(getLocalBounds().reduced(3)));
+
+    return changed;
 }
 
 juce::Rectangle<int> SpectrumAnalyzer::getRenderArea(juce::Rectangle<int> bounds)
@@ -351,3 +624,113 @@ juce::Rectangle<int> SpectrumAnalyzer::getAnalysisArea(juce::Rectangle<int> boun
     bounds.removeFromBottom(4);
     return bounds;
 }
+
+void SpectrumAnalyzer::mouseDown(const juce::MouseEvent& e)
+{
+    if (!e.mods.isPopupMenu())
+        return;
+
+    juce::PopupMenu menu;
+    menu.addItem("Measure transfer function (mutes the output)", !waitingForMeasurement, false, [this]() { startMeasurement(); });
+    menu.addItem("Clear measurement", waitingForMeasurement || !measuredResponse.isEmpty(), false, [this]() { clearMeasurement(); });
+
+    menu.showMenuAsync(juce::PopupMenu::Options());
+}
+
+void SpectrumAnalyzer::startMeasurement()
+{
+    //the sweep starts with the next block, so nothing happens while the host is stopped.
+    audioProcessor.measurement.start();
+    waitingForMeasurement = true;
+    repaint(getAnalysisArea(getLocalBounds().reduced(3)));
+}
+
+void SpectrumAnalyzer::clearMeasurement()
+{
+    if (waitingForMeasurement)
+        audioProcessor.measurement.cancel();
+
+    waitingForMeasurement = false;
+    computingResponse = false;
+    responseMailbox = std::make_shared<ResponseMailbox>();
+    measuredResponse = {};
+    measuredResponsePath.clear();
+    repaint(getAnalysisArea(getLocalBounds().reduced(3)));
+}
+
+bool SpectrumAnalyzer::updateMeasurement()
+{
+    auto& measurement = audioProcessor.measurement;
+
+    //prepareToPlay() dropped it, or it never started.
+    if (measurement.isCancelled() || !(measurement.isRunning() || measurement.isComplete()))
+    {
+        waitingForMeasurement = false;
+        computingResponse = false;
+        return true;
+    }
+
+    if (!computingResponse)
+    {
+        if (!measurement.isComplete())
+            return false;
+
+        //the recording is copied here, so the job doesn't need the processor to outlive it.
+        computingResponse = true;
+        backgroundJobs->pool.addJob([mailbox = responseMailbox, recording = measurement.getRecording()]()
+            {
+                mailbox->post(std::make_unique<TransferFunctionMeasurement::Response>(TransferFunctionMeasurement::computeResponse(recording)));
+            });
+
+        return false;
+    }
+
+    auto response = responseMailbox->collect();
+    if (response == nullptr)
+        return false;
+
+    waitingForMeasurement = false;
+    computingResponse = false;
+    measuredResponse = std::move(*response);
+    updateMeasuredResponsePath();
+    return true;
+}
+
+void SpectrumAnalyzer::updateMeasuredResponsePath()
+{
+    using namespace juce;
+    measuredResponsePath.clear();
+
+    if (measuredResponse.isEmpty())
+        return;
+
+    auto area = getAnalysisArea(getLocalBounds().reduced(3)).toFloat();
+
+    for (size_t i = 0; i < measuredResponse.frequencies.size(); ++i)
+    {
+        auto x = area.getX() + area.getWidth() * mapFromLog10(measuredResponse.frequencies[i], MIN_FREQUENCY, MAX_FREQUENCY);
+        auto db = jlimit(NEGATIVE_INFINITY, MAX_DECIBELS, measuredResponse.magnitudedB[i]);
+        auto y = jmap(db, NEGATIVE_INFINITY, MAX_DECIBELS, area.getBottom(), area.getY());
+
+        if (i == 0)
+            measuredResponsePath.startNewSubPath(x, y);
+        else
+            measuredResponsePath.lineTo(x, y);
+    }
+}
+
+void SpectrumAnalyzer::drawMeasuredResponse(juce::Graphics& g, juce::Rectangle<int> bounds)
+{
+    if (waitingForMeasurement)
+    {
+        g.setColour(juce::Colours::white);
+        g.setFont(12.f);
+        g.drawText("measuring...", getAnalysisArea(bounds).reduced(4), juce::Justification::topRight);
+    }
+
+    if (!measuredResponsePath.isEmpty())
+    {
+        g.setColour(juce::Colours::white.withAlpha(0.8f));
+        g.strokePath(measuredResponsePath, juce::PathStrokeType(1.5f));
+    }
+}
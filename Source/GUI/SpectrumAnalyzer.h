@@ -12,10 +12,11 @@
 #include <JuceHeader.h>
 #include "../PluginProcessor.h"
 #include "../GUI/PathProducer.h"
+#include "../GUI/FrameScheduler.h"
 
 struct SpectrumAnalyzer : juce::Component,
     juce::AudioProcessorParameter::Listener,
-    juce::Timer
+    FrameScheduler::Client
 {
     SpectrumAnalyzer(SimpleMBCompAudioProcessor&);
     ~SpectrumAnalyzer();
@@ -24,24 +25,53 @@ struct SpectrumAnalyzer : juce::Component,
 
     void parameterGestureChanged(int parameterIndex, bool gestureIsStarting) override { }
 
-    void timerCallback() override;
+    bool updateFrame() override;
 
     void paint(juce::Graphics& g) override;
     void resized() override;
 
-    void toggleAnalysisEnablement(bool enabled)
-    {
-        shouldShowFFTAnalysis = enabled;
-    }
+    //right click: measure the processor's transfer function, or clear the last measurement.
+    void mouseDown(const juce::MouseEvent& e) override;
+
+    void toggleAnalysisEnablement(bool enabled);
+
+    void setFFTOrder(FFTOrder newOrder);
+    void setMultiResolutionEnabled(bool enabled);
+    void setOverlap(int overlapFactor);
+    void setAveragingTime(float seconds);
+    void setPeakHoldEnabled(bool enabled);
+    void setTraceAntiAliasing(bool shouldAntiAlias);
+
+    //the spectrogram follows the left channel of the first enabled tap.
+    void setSpectrogramEnabled(bool enabled);
+    const Spectrogram& getSpectrogram() const { return spectrogram; }
 
-    void update(const std::vector<float>& values);
+    /*
+     a tap's path producers only exist (and the processor only feeds its fifos) while it's enabled
+     and the analyzer is on screen: an editor that isn't showing holds no FFTs.
+     */
+    void setTapEnabled(AnalyzerTap tap, bool enabled);
+    bool isTapEnabled(AnalyzerTap tap) const { return enabledTaps[tap]; }
+
+    //returns true if any band's gain reduction changed, and repaints just those bands.
+    bool update(const std::array<float, 3>& gainReductiondB);
 private:
     SimpleMBCompAudioProcessor& audioProcessor;
 
     bool shouldShowFFTAnalysis = true;
+    float negativeInfinity = NEGATIVE_INFINITY;
 
     juce::Atomic<bool> parametersChanged{ false };
 
+    /*
+     the frame, grid and labels only change with the size or the display scale,
+     so they're drawn once into this image and blitted every frame.
+     */
+    juce::Image backgroundImage;
+    float backgroundScale = 0.f;
+
+    void renderBackgroundImage(float scale);
+
     //void drawBackgroundGrid(juce::Graphics& g);
     void drawBackgroundGrid(juce::Graphics& g, juce::Rectangle<int> bounds);
 
@@ -55,11 +85,97 @@ private:
 
     juce::Rectangle<int> getAnalysisArea(juce::Rectangle<int> bounds);
 
-    PathProducer leftPathProducer, rightPathProducer;
+    //the part of the analysis area the gain reduction for 'band' (0 = low) is drawn in.
+    juce::Rectangle<int> getBandArea(int band);
+
+    struct TapPathProducers
+    {
+        TapPathProducers(SimpleMBCompAudioProcessor::AnalyzerTapFifos& fifos, FFTOrder order) :
+            left(fifos.left, order),
+            right(fifos.right, order)
+        { }
+
+        PathProducer left, right;
+    };
+
+    Spectrogram spectrogram;
+    bool showSpectrogram = false;
+    PathProducer* spectrogramSource = nullptr;
+
+    std::array<std::unique_ptr<TapPathProducers>, NumAnalyzerTaps> tapProducers;
+    std::array<bool, NumAnalyzerTaps> enabledTaps{};
+
+    //only true while the analyzer is showing: allocated on the first frame it is, released on the first it isn't.
+    bool resourcesAllocated = false;
+    void allocateResources();
+    void releaseResources();
+
+    void createTapProducers(AnalyzerTap tap);
+    void destroyTapProducers(AnalyzerTap tap);
+
+    void updateSpectrogramSource();
+
+    //applied to taps when they're enabled, so a new tap matches the ones already showing.
+    struct AnalysisSettings
+    {
+        FFTOrder order = FFTOrder::order8192;
+        bool multiResolution = false;
+        int overlap = 8;
+        float averagingTime = 0.f;
+        bool peakHold = false;
+    } settings;
+
+    void subscribeTap(AnalyzerTap tap);
+
+    template<typename Func>
+    void forEachPathProducer(Func&& func)
+    {
+        for (auto& tap : tapProducers)
+        {
+            if (tap != nullptr)
+            {
+                func(tap->left);
+                func(tap->right);
+            }
+        }
+    }
+
+    SpectrumTraceRenderer traceRenderer;
 
     void drawFFTAnalysis(juce::Graphics& g, juce::Rectangle<int> bounds);
     void drawCrossovers(juce::Graphics& g, juce::Rectangle<int> bounds);
 
+    //the magnitude of the last transfer function measurement, over the analysis area.
+    TransferFunctionMeasurement::Response measuredResponse;
+    juce::Path measuredResponsePath;
+    bool waitingForMeasurement = false;
+    bool computingResponse = false;
+
+    /*
+     the deconvolution runs on the FFT plan builder's thread and the result is picked up by
+     updateFrame(). a cleared measurement gets a new mailbox, so a job still running for it
+     writes somewhere nobody reads.
+     */
+    struct ResponseMailbox
+    {
+        ~ResponseMailbox() { delete pending.exchange(nullptr); }
+
+        void post(std::unique_ptr<TransferFunctionMeasurement::Response> response) { delete pending.exchange(response.release()); }
+        std::unique_ptr<TransferFunctionMeasurement::Response> collect() { return std::unique_ptr<TransferFunctionMeasurement::Response>(pending.exchange(nullptr)); }
+
+        std::atomic<TransferFunctionMeasurement::Response*> pending{ nullptr };
+    };
+
+    std::shared_ptr<ResponseMailbox> responseMailbox{ std::make_shared<ResponseMailbox>() };
+    juce::SharedResourcePointer<FFTPlanBuilder> backgroundJobs;
+
+    void startMeasurement();
+    void clearMeasurement();
+    //returns true if the measurement finished or was cancelled.
+    bool updateMeasurement();
+    void updateMeasuredResponsePath();
+    void drawMeasuredResponse(juce::Graphics& g, juce::Rectangle<int> bounds);
+
 
     juce::AudioParameterFloat* lowMidXoverParam{ nullptr };
     juce::AudioParameterFloat* midHighXoverParam{ nullptr };
@@ -68,6 +184,23 @@ private:
     juce::AudioParameterFloat* midThresholdParam{ nullptr };
     juce::AudioParameterFloat* highThresholdParam{ nullptr };
 
+    std::array<juce::AudioParameterFloat*, 5> getOverlayParams() const
+    {
+        return { lowMidXoverParam, midHighXoverParam, lowThresholdParam, midThresholdParam, highThresholdParam };
+    }
+
+    //pixel positions of the overlay params, recomputed only when one of them changes or on resize.
+    struct OverlayGeometry
+    {
+        float lowMidX = 0.f;
+        float midHighX = 0.f;
+        float lowThresholdY = 0.f;
+        float midThresholdY = 0.f;
+        float highThresholdY = 0.f;
+    } overlay;
+
+    void updateOverlayGeometry();
+
     float lowBandGR{ 0.f };
     float midBandGR{ 0.f };
     float highBandGR{ 0.f };
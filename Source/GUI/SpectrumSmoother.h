@@ -0,0 +1,109 @@
+/*
+  ==============================================================================
+
+    SpectrumSmoother.h
+    Created: 19 Oct 2026 11:12:37am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+#include <vector>
+#include "Utilities.h"
+#include "FastDecibels.h"
+
+/*
+ exponential averaging and a decaying peak-hold trace over dB spectra.
+ the average is taken over power (magnitude squared) and only turned back into dB when it's
+ read: averaging the dB values themselves would sit low on noisy spectra.
+ the buffers are sized once in prepare(), process() doesn't allocate.
+ */
+struct SpectrumSmoother
+{
+    void prepare(int numBins, float negativeInfinity)
+    {
+        floor = negativeInfinity;
+        averagedPower.assign(static_cast<size_t>(numBins), decibelsToPower(negativeInfinity));
+        averaged.assign(static_cast<size_t>(numBins), negativeInfinity);
+        peaks.assign(static_cast<size_t>(numBins), negativeInfinity);
+        averagedIsStale = false;
+    }
+
+    void reset()
+    {
+        std::fill(averagedPower.begin(), averagedPower.end(), decibelsToPower(floor));
+        std::fill(averaged.begin(), averaged.end(), floor);
+        std::fill(peaks.begin(), peaks.end(), floor);
+        averagedIsStale = false;
+    }
+
+    //0 turns averaging off.
+    void setTimeConstant(float seconds) { timeConstantSeconds = juce::jmax(0.f, seconds); }
+    void setPeakDecayRate(float decibelsPerSecond) { peakDecayDbPerSecond = juce::jmax(0.f, decibelsPerSecond); }
+
+    /*
+     folds one frame of 'numBins' dB values into the averaged and peak buffers.
+     'elapsedSeconds' is the audio time since the previous frame passed in: a hop, or more
+     if frames were dropped before this one.
+     */
+    void process(const float* frame, int numBins, float elapsedSeconds)
+    {
+        jassert(numBins <= static_cast<int>(averaged.size()));
+        numBins = juce::jmin(numBins, static_cast<int>(averaged.size()));
+
+        using FVO = juce::FloatVectorOperations;
+
+        //with averaging off the power still follows along, so turning it on starts from the current level.
+        auto coefficient = timeConstantSeconds > 0.f ? 1.f - std::exp(-elapsedSeconds / timeConstantSeconds) : 1.f;
+        for (int i = 0; i < numBins; ++i)
+            averagedPower[i] += coefficient * (decibelsToPower(frame[i]) - averagedPower[i]);
+
+        if (timeConstantSeconds > 0.f)
+        {
+            averagedIsStale = true;
+        }
+        else
+        {
+            FVO::copy(averaged.data(), frame, numBins);
+            averagedIsStale = false;
+        }
+
+        FVO::add(peaks.data(), -peakDecayDbPerSecond * elapsedSeconds, numBins);
+        FVO::max(peaks.data(), peaks.data(), frame, numBins);
+        FVO::max(peaks.data(), peaks.data(), floor, numBins);
+    }
+
+    //the averaged power in dB, converted once per batch of frames rather than once per frame.
+    const std::vector<float>& getAveraged()
+    {
+        if (averagedIsStale)
+        {
+            constexpr auto dBPerOctave = 3.0103f; // 10 * log10(2)
+            const auto minPower = decibelsToPower(floor);
+
+            for (size_t i = 0; i < averaged.size(); ++i)
+                averaged[i] = juce::jmax(fastLog2(juce::jmax(averagedPower[i], minPower)) * dBPerOctave, floor);
+
+            averagedIsStale = false;
+        }
+
+        return averaged;
+    }
+
+    const std::vector<float>& getPeaks() const { return peaks; }
+private:
+    std::vector<float> averagedPower, averaged, peaks;
+    bool averagedIsStale = false;
+    float floor = NEGATIVE_INFINITY;
+    float timeConstantSeconds = 0.f;
+    float peakDecayDbPerSecond = 20.f;
+
+    static float decibelsToPower(float decibels)
+    {
+        constexpr auto octavesPerDecibel = 0.33219281f; // 1 / (10 * log10(2))
+        return std::exp2(decibels * octavesPerDecibel);
+    }
+};
@@ -0,0 +1,117 @@
+/*
+  ==============================================================================
+
+    SpectrumTraceRenderer.cpp
+    Created: 19 Oct 2026 4:31:55pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "SpectrumTraceRenderer.h"
+
+void SpectrumTraceRenderer::begin(int width, int height, float scale)
+{
+    renderScale = scale;
+
+    auto pixelWidth = juce::jmax(1, juce::roundToInt(width * scale));
+    auto pixelHeight = juce::jmax(1, juce::roundToInt(height * scale));
+
+    if (!image.isValid() || image.getWidth() != pixelWidth || image.getHeight() != pixelHeight)
+    {
+        //fillSpan writes PixelARGB directly, which only a software image guarantees
+        image = juce::Image(juce::Image::ARGB, pixelWidth, pixelHeight, true, juce::SoftwareImageType());
+        return;
+    }
+
+    juce::Image::BitmapData data(image, juce::Image::BitmapData::writeOnly);
+    for (int y = 0; y < data.height; ++y)
+        juce::zeromem(data.getLinePointer(y), (size_t)(data.width * data.pixelStride));
+}
+
+void SpectrumTraceRenderer::drawTrace(const SpectrumTrace& trace, float yOffset, juce::Colour colour)
+{
+    const auto& ys = trace.ys;
+    const auto numColumns = (int)ys.size();
+    if (numColumns == 0 || !image.isValid())
+        return;
+
+    juce::Image::BitmapData data(image, juce::Image::BitmapData::readWrite);
+    jassert(data.pixelFormat == juce::Image::ARGB);
+    const auto pixel = colour.getPixelARGB();
+    const auto scale = renderScale;
+
+    //the trace's y at a fractional column, in pixels.
+    auto yAt = [&ys, numColumns, yOffset, scale](float column)
+        {
+            column = juce::jlimit(0.f, (float)(numColumns - 1), column);
+            auto index = (int)column;
+            auto next = juce::jmin(index + 1, numColumns - 1);
+            auto frac = column - (float)index;
+            return (ys[index] + frac * (ys[next] - ys[index]) + yOffset) * scale;
+        };
+
+    auto firstPixel = juce::jmax(0, (int)std::ceil(trace.startX * scale));
+    auto lastPixel = juce::jmin(data.width, (int)std::floor((trace.startX + (float)(numColumns - 1)) * scale) + 1);
+
+    //the same 1pt thickness strokePath() used.
+    const auto halfThickness = 0.5f * scale;
+    auto previousY = yAt((float)firstPixel / scale - trace.startX);
+
+    for (int x = firstPixel; x < lastPixel; ++x)
+    {
+        auto y = yAt((float)x / scale - trace.startX);
+
+        //joins this column to the previous one, so steep slopes stay connected.
+        fillSpan(data,
+            x,
+            juce::jmin(previousY, y) - halfThickness,
+            juce::jmax(previousY, y) + halfThickness,
+            pixel);
+
+        previousY = y;
+    }
+}
+
+void SpectrumTraceRenderer::fillSpan(juce::Image::BitmapData& data, int x, float top, float bottom, const juce::PixelARGB& colour) const
+{
+    top = juce::jmax(0.f, top);
+    bottom = juce::jmin((float)data.height, bottom);
+    if (!(bottom > top))
+        return;
+
+    auto blendRow = [&data, x, &colour](int row, juce::uint32 alpha)
+        {
+            reinterpret_cast<juce::PixelARGB*>(data.getPixelPointer(x, row))->blend(colour, alpha);
+        };
+
+    if (!antiAliased)
+    {
+        auto firstRow = juce::roundToInt(top);
+        auto lastRow = juce::jmax(firstRow + 1, juce::roundToInt(bottom));
+
+        for (int row = firstRow; row < juce::jmin(lastRow, data.height); ++row)
+            blendRow(row, 255);
+
+        return;
+    }
+
+    //the partially covered rows at either end get a fraction of the alpha.
+    auto firstRow = (int)top;
+    auto lastRow = juce::jmin(data.height, (int)std::ceil(bottom));
+
+    for (int row = firstRow; row < lastRow; ++row)
+    {
+        auto coverage = juce::jmin(bottom, (float)(row + 1)) - juce::jmax(top, (float)row);
+        auto alpha = (juce::uint32)juce::roundToInt(coverage * 255.f);
+
+        if (alpha > 0)
+            blendRow(row, alpha);
+    }
+}
+
+void SpectrumTraceRenderer::draw(juce::Graphics& g, juce::Rectangle<int> area) const
+{
+    if (image.isValid())
+        g.drawImage(image, area.toFloat());
+}
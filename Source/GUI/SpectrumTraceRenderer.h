@@ -0,0 +1,59 @@
+/*
+  ==============================================================================
+
+    SpectrumTraceRenderer.h
+    Created: 19 Oct 2026 4:31:55pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+/*
+ one y value per pixel column, starting at 'startX'.
+ it has the bits of the juce::Path interface AnalyzerPathGenerator uses, so it can be
+ generated the same way. the generator only ever steps x by one column, so x isn't stored.
+ */
+struct SpectrumTrace
+{
+    void preallocateSpace(int numValues) { ys.reserve((size_t)numValues); }
+    void startNewSubPath(float x, float y)
+    {
+        startX = x;
+        ys.clear();
+        ys.push_back(y);
+    }
+    void lineTo(float, float y) { ys.push_back(y); }
+    void clear() { ys.clear(); }
+    bool isEmpty() const { return ys.empty(); }
+
+    float startX = 0.f;
+    std::vector<float> ys;
+};
+
+/*
+ rasterizes SpectrumTraces straight into a reused ARGB image as one vertical span per
+ pixel column, instead of building and stroking a juce::Path per trace.
+ */
+struct SpectrumTraceRenderer
+{
+    //sizes the image for an area of width x height at 'scale' physical pixels per point, and clears it.
+    void begin(int width, int height, float scale);
+
+    //'yOffset' is added to the trace's y values (in points) before drawing.
+    void drawTrace(const SpectrumTrace& trace, float yOffset, juce::Colour colour);
+
+    //draws what's been rendered since begin() over 'area'.
+    void draw(juce::Graphics& g, juce::Rectangle<int> area) const;
+
+    void setAntiAliased(bool shouldAntiAlias) { antiAliased = shouldAntiAlias; }
+private:
+    juce::Image image;
+    float renderScale = 1.f;
+    bool antiAliased = true;
+
+    void fillSpan(juce::Image::BitmapData& data, int x, float top, float bottom, const juce::PixelARGB& colour) const;
+};
@@ -0,0 +1,216 @@
+/*
+  ==============================================================================
+
+    SwitchableAttachments.cpp
+    Created: 19 Oct 2026 7:35:14pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "SwitchableAttachments.h"
+
+SwitchableSliderAttachment::SwitchableSliderAttachment(juce::Slider& sliderToControl,
+    const std::vector<juce::RangedAudioParameter*>& parameters) :
+    slider(sliderToControl),
+    params(parameters)
+{
+    for (int i = 0; i < (int)params.size(); ++i)
+    {
+        jassert(params[i] != nullptr);
+        attachments.push_back(std::make_unique<juce::ParameterAttachment>(*params[i],
+            [this, i](float newValue)
+            {
+                if (i == activeIndex)
+                    queueSliderValue(newValue);
+            }));
+    }
+
+    slider.addListener(this);
+}
+
+SwitchableSliderAttachment::SwitchableSliderAttachment(juce::AudioProcessorValueTreeState& apvts,
+    const juce::String& parameterID,
+    juce::Slider& sliderToControl) :
+    SwitchableSliderAttachment(sliderToControl, { apvts.getParameter(parameterID) })
+{
+    setActiveIndex(0);
+}
+
+SwitchableSliderAttachment::~SwitchableSliderAttachment()
+{
+    slider.removeListener(this);
+}
+
+void SwitchableSliderAttachment::setActiveIndex(int newIndex)
+{
+    jassert(juce::isPositiveAndBelow(newIndex, (int)params.size()));
+    if (newIndex == activeIndex)
+        return;
+
+    activeIndex = newIndex;
+
+    //whatever was queued belongs to the previous parameter.
+    hasPendingValue = false;
+
+    auto& param = *params[activeIndex];
+    configureSlider(param);
+    setSliderValue(param.convertFrom0to1(param.getValue()));
+}
+
+void SwitchableSliderAttachment::configureSlider(juce::RangedAudioParameter& param)
+{
+    //what SliderParameterAttachment does on construction.
+    slider.valueFromTextFunction = [&param](const juce::String& text) { return (double)param.convertFrom0to1(param.getValueForText(text)); };
+    slider.textFromValueFunction = [&param](double value) { return param.getText(param.convertTo0to1((float)value), 0); };
+
+    auto range = param.getNormalisableRange();
+
+    auto convertFrom0To1Function = [range](double currentRangeStart, double currentRangeEnd, double normalisedValue) mutable
+        {
+            range.start = (float)currentRangeStart;
+            range.end = (float)currentRangeEnd;
+            return (double)range.convertFrom0to1((float)normalisedValue);
+        };
+
+    auto convertTo0To1Function = [range](double currentRangeStart, double currentRangeEnd, double mappedValue) mutable
+        {
+            range.start = (float)currentRangeStart;
+            range.end = (float)currentRangeEnd;
+            return (double)range.convertTo0to1((float)mappedValue);
+        };
+
+    auto snapToLegalValueFunction = [range](double currentRangeStart, double currentRangeEnd, double mappedValue) mutable
+        {
+            range.start = (float)currentRangeStart;
+            range.end = (float)currentRangeEnd;
+            return (double)range.snapToLegalValue((float)mappedValue);
+        };
+
+    juce::NormalisableRange<double> newRange{ (double)range.start,
+                                              (double)range.end,
+                                              std::move(convertFrom0To1Function),
+                                              std::move(convertTo0To1Function),
+                                              std::move(snapToLegalValueFunction) };
+    newRange.interval = range.interval;
+    newRange.skew = range.skew;
+    newRange.symmetricSkew = range.symmetricSkew;
+
+    juce::ScopedValueSetter<bool> svs(ignoreCallbacks, true);
+    slider.setNormalisableRange(newRange);
+    slider.setDoubleClickReturnValue(true, range.convertFrom0to1(param.getDefaultValue()));
+}
+
+void SwitchableSliderAttachment::queueSliderValue(float newValue)
+{
+    //the slider's own edits come straight back through here and are already shown.
+    if ((double)newValue == slider.getValue())
+    {
+        hasPendingValue = false;
+        return;
+    }
+
+    //the first change since the last frame goes through straight away, the rest wait for the next one.
+    if (!shownSinceLastFrame)
+    {
+        setSliderValue(newValue);
+        shownSinceLastFrame = true;
+        return;
+    }
+
+    pendingValue = newValue;
+    hasPendingValue = true;
+}
+
+bool SwitchableSliderAttachment::updateFrame()
+{
+    if (!hasPendingValue)
+    {
+        auto changed = shownSinceLastFrame;
+        shownSinceLastFrame = false;
+        return changed;
+    }
+
+    hasPendingValue = false;
+    setSliderValue(pendingValue);
+    return true;
+}
+
+void SwitchableSliderAttachment::setSliderValue(float newValue)
+{
+    juce::ScopedValueSetter<bool> svs(ignoreCallbacks, true);
+    slider.setValue(newValue, juce::sendNotificationSync);
+}
+
+void SwitchableSliderAttachment::sliderValueChanged(juce::Slider*)
+{
+    if (ignoreCallbacks || activeIndex < 0)
+        return;
+
+    if (slider.isMouseButtonDown())
+        attachments[activeIndex]->setValueAsPartOfGesture((float)slider.getValue());
+    else
+        attachments[activeIndex]->setValueAsCompleteGesture((float)slider.getValue());
+}
+
+void SwitchableSliderAttachment::sliderDragStarted(juce::Slider*)
+{
+    if (activeIndex >= 0)
+        attachments[activeIndex]->beginGesture();
+}
+
+void SwitchableSliderAttachment::sliderDragEnded(juce::Slider*)
+{
+    if (activeIndex >= 0)
+        attachments[activeIndex]->endGesture();
+}
+//==============================================================================
+SwitchableButtonAttachment::SwitchableButtonAttachment(juce::Button& buttonToControl,
+    const std::vector<juce::RangedAudioParameter*>& parameters) :
+    button(buttonToControl),
+    params(parameters)
+{
+    for (int i = 0; i < (int)params.size(); ++i)
+    {
+        jassert(params[i] != nullptr);
+        attachments.push_back(std::make_unique<juce::ParameterAttachment>(*params[i],
+            [this, i](float newValue)
+            {
+                if (i == activeIndex)
+                    setButtonState(newValue);
+            }));
+    }
+
+    button.addListener(this);
+}
+
+SwitchableButtonAttachment::~SwitchableButtonAttachment()
+{
+    button.removeListener(this);
+}
+
+void SwitchableButtonAttachment::setActiveIndex(int newIndex, juce::NotificationType notification)
+{
+    jassert(juce::isPositiveAndBelow(newIndex, (int)params.size()));
+    if (newIndex == activeIndex)
+        return;
+
+    activeIndex = newIndex;
+
+    auto& param = *params[activeIndex];
+    setButtonState(param.convertFrom0to1(param.getValue()), notification);
+}
+
+void SwitchableButtonAttachment::setButtonState(float newValue, juce::NotificationType notification)
+{
+    juce::ScopedValueSetter<bool> svs(ignoreCallbacks, true);
+    button.setToggleState(newValue >= 0.5f, notification);
+}
+
+void SwitchableButtonAttachment::buttonClicked(juce::Button*)
+{
+    if (ignoreCallbacks || activeIndex < 0)
+        return;
+
+    attachments[activeIndex]->setValueAsCompleteGesture(button.getToggleState() ? 1.f : 0.f);
+}
@@ -0,0 +1,82 @@
+/*
+  ==============================================================================
+
+    SwitchableAttachments.h
+    Created: 19 Oct 2026 7:35:14pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <memory>
+#include <vector>
+#include "FrameScheduler.h"
+
+/*
+ binds one slider to whichever of several parameters is active.
+ every parameter gets its ParameterAttachment (and host listener) once, up front;
+ setActiveIndex() only changes which of them the slider follows and writes to.
+
+ parameter changes reach the slider at most once per frame (the latest one wins),
+ so host automation doesn't repaint the knob faster than it can be seen. the component
+ holding the attachments passes the editor's frames on to updateFrame().
+ */
+struct SwitchableSliderAttachment : juce::Slider::Listener, FrameScheduler::Client
+{
+    SwitchableSliderAttachment(juce::Slider& sliderToControl, const std::vector<juce::RangedAudioParameter*>& parameters);
+
+    //same signature as APVTS::SliderAttachment, for a slider that only ever has the one parameter.
+    SwitchableSliderAttachment(juce::AudioProcessorValueTreeState& apvts, const juce::String& parameterID, juce::Slider& sliderToControl);
+
+    ~SwitchableSliderAttachment() override;
+
+    void setActiveIndex(int newIndex);
+
+    void sliderValueChanged(juce::Slider*) override;
+    void sliderDragStarted(juce::Slider*) override;
+    void sliderDragEnded(juce::Slider*) override;
+
+    bool updateFrame() override;
+private:
+    juce::Slider& slider;
+    std::vector<juce::RangedAudioParameter*> params;
+    std::vector<std::unique_ptr<juce::ParameterAttachment>> attachments;
+    int activeIndex = -1;
+    bool ignoreCallbacks = false;
+
+    float pendingValue = 0.f;
+    bool hasPendingValue = false;
+    bool shownSinceLastFrame = false;
+    void queueSliderValue(float newValue);
+
+    void setSliderValue(float newValue);
+    void configureSlider(juce::RangedAudioParameter& param);
+};
+
+/*
+ the same for a toggle button.
+ */
+struct SwitchableButtonAttachment : juce::Button::Listener
+{
+    SwitchableButtonAttachment(juce::Button& buttonToControl, const std::vector<juce::RangedAudioParameter*>& parameters);
+    ~SwitchableButtonAttachment() override;
+
+    /*
+     with dontSendNotification the button's other listeners don't hear about the new state.
+     use that when several attachments switch together: a listener reacting to one of them
+     could otherwise write through another that's still on the old index.
+     */
+    void setActiveIndex(int newIndex, juce::NotificationType notification = juce::sendNotificationSync);
+
+    void buttonClicked(juce::Button*) override;
+private:
+    juce::Button& button;
+    std::vector<juce::RangedAudioParameter*> params;
+    std::vector<std::unique_ptr<juce::ParameterAttachment>> attachments;
+    int activeIndex = -1;
+    bool ignoreCallbacks = false;
+
+    void setButtonState(float newValue, juce::NotificationType notification = juce::sendNotificationSync);
+};
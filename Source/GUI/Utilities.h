@@ -23,7 +23,8 @@ enum FFTOrder
 {
     order2048 = 11,
     order4096 = 12,
-    order8192 = 13
+    order8192 = 13,
+    order16384 = 14
 };
 
 enum Channel
@@ -32,6 +33,17 @@ enum Channel
     Left //effectively 1
 };
 
+//points in processBlock that can feed the analyzer.
+enum AnalyzerTap
+{
+    InputTap,
+    OutputTap,
+    LowBandTap,
+    MidBandTap,
+    HighBandTap,
+    NumAnalyzerTaps
+};
+
 template<
     typename Attachment,
     typename APVTS,
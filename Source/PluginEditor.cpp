@@ -16,6 +16,59 @@ ControlBar::ControlBar()
 {
     analyzerButton.setToggleState(true, juce::NotificationType::dontSendNotification);
     addAndMakeVisible(analyzerButton);
+
+    //item ids are the FFTOrder / overlap factor themselves.
+    for (auto order : { FFTOrder::order2048, FFTOrder::order4096, FFTOrder::order8192, FFTOrder::order16384 })
+        resolutionComboBox.addItem(juce::String(1 << order), order);
+
+    resolutionComboBox.addItem("Multi-res", multiResolutionItemId);
+
+    resolutionComboBox.setSelectedId(FFTOrder::order8192, juce::NotificationType::dontSendNotification);
+    addAndMakeVisible(resolutionComboBox);
+
+    for (auto overlap : { 1, 2, 4, 8 })
+        overlapComboBox.addItem(juce::String(overlap) + "x", overlap);
+
+    overlapComboBox.setSelectedId(8, juce::NotificationType::dontSendNotification);
+    addAndMakeVisible(overlapComboBox);
+
+    //item ids are the averaging time constant in ms, +1 so 'Off' isn't 0.
+    averagingComboBox.addItem("Avg Off", 1);
+    averagingComboBox.addItem("Avg 100ms", 101);
+    averagingComboBox.addItem("Avg 300ms", 301);
+    averagingComboBox.addItem("Avg 1s", 1001);
+    averagingComboBox.setSelectedId(1, juce::NotificationType::dontSendNotification);
+    addAndMakeVisible(averagingComboBox);
+
+    peakHoldButton.setName("pk");
+    peakHoldButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::forestgreen);
+    peakHoldButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::dimgrey);
+    addAndMakeVisible(peakHoldButton);
+
+    //indexed by AnalyzerTap
+    const char* tapNames[] = { "in", "out", "lo", "mid", "hi" };
+    for (int tap = 0; tap < NumAnalyzerTaps; ++tap)
+    {
+        auto& button = tapButtons[tap];
+        button.setName(tapNames[tap]);
+        button.setColour(juce::TextButton::ColourIds::buttonOnColourId, ColorScheme::getAnalyzerTapColor(tap));
+        button.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::dimgrey);
+        addAndMakeVisible(button);
+    }
+
+    tapButtons[InputTap].setToggleState(true, juce::NotificationType::dontSendNotification);
+
+    spectrogramButton.setName("sg");
+    spectrogramButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::forestgreen);
+    spectrogramButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::dimgrey);
+    addAndMakeVisible(spectrogramButton);
+
+    gainReductionHistoryButton.setName("gr");
+    gainReductionHistoryButton.setColour(juce::TextButton::ColourIds::buttonOnColourId, juce::Colours::forestgreen);
+    gainReductionHistoryButton.setColour(juce::TextButton::ColourIds::buttonColourId, juce::Colours::dimgrey);
+    addAndMakeVisible(gainReductionHistoryButton);
+
+    addAndMakeVisible(dspLoadDisplay);
     addAndMakeVisible(globalBypassButton);
 }
 
@@ -23,7 +76,28 @@ void ControlBar::resized()
 {
     auto bounds = getLocalBounds();
     analyzerButton.setBounds(bounds.removeFromLeft(50).withTrimmedTop(4).withTrimmedBottom(4));
+    bounds.removeFromLeft(4);
+    resolutionComboBox.setBounds(bounds.removeFromLeft(70).withTrimmedTop(2).withTrimmedBottom(2));
+    bounds.removeFromLeft(4);
+    overlapComboBox.setBounds(bounds.removeFromLeft(44).withTrimmedTop(2).withTrimmedBottom(2));
+    bounds.removeFromLeft(4);
+    averagingComboBox.setBounds(bounds.removeFromLeft(74).withTrimmedTop(2).withTrimmedBottom(2));
+    bounds.removeFromLeft(4);
+    //the toggles are packed tight so the load display fits without squeezing the bypass button.
+    peakHoldButton.setBounds(bounds.removeFromLeft(24));
+    bounds.removeFromLeft(2);
+
+    for (auto& button : tapButtons)
+        button.setBounds(bounds.removeFromLeft(22));
+
+    bounds.removeFromLeft(2);
+    spectrogramButton.setBounds(bounds.removeFromLeft(24));
+    bounds.removeFromLeft(2);
+    gainReductionHistoryButton.setBounds(bounds.removeFromLeft(24));
+
     globalBypassButton.setBounds(bounds.removeFromRight(60).withTrimmedTop(2).withTrimmedBottom(2));
+    bounds.removeFromRight(2);
+    dspLoadDisplay.setBounds(bounds.removeFromRight(46));
 }
 //==============================================================================
 SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor& p)
@@ -39,6 +113,54 @@ SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBComp
             analyzer.toggleAnalysisEnablement(shouldBeOn);
         };
 
+    controlBar.resolutionComboBox.onChange = [this]()
+        {
+            auto id = controlBar.resolutionComboBox.getSelectedId();
+            if (id == ControlBar::multiResolutionItemId)
+            {
+                analyzer.setMultiResolutionEnabled(true);
+            }
+            else
+            {
+                analyzer.setFFTOrder(static_cast<FFTOrder>(id));
+                analyzer.setMultiResolutionEnabled(false);
+            }
+        };
+
+    controlBar.overlapComboBox.onChange = [this]()
+        {
+            analyzer.setOverlap(controlBar.overlapComboBox.getSelectedId());
+        };
+
+    controlBar.averagingComboBox.onChange = [this]()
+        {
+            auto milliseconds = controlBar.averagingComboBox.getSelectedId() - 1;
+            analyzer.setAveragingTime(milliseconds * 0.001f);
+        };
+
+    controlBar.peakHoldButton.onClick = [this]()
+        {
+            analyzer.setPeakHoldEnabled(controlBar.peakHoldButton.getToggleState());
+        };
+
+    for (int tap = 0; tap < NumAnalyzerTaps; ++tap)
+    {
+        controlBar.tapButtons[tap].onClick = [this, tap]()
+            {
+                analyzer.setTapEnabled(static_cast<AnalyzerTap>(tap), controlBar.tapButtons[tap].getToggleState());
+            };
+    }
+
+    controlBar.spectrogramButton.onClick = [this]()
+        {
+            setSpectrogramVisible(controlBar.spectrogramButton.getToggleState());
+        };
+
+    controlBar.gainReductionHistoryButton.onClick = [this]()
+        {
+            setGainReductionHistoryVisible(controlBar.gainReductionHistoryButton.getToggleState());
+        };
+
     controlBar.globalBypassButton.onClick = [this]() {
         toggleGlobalBypassState();
         };
@@ -47,10 +169,21 @@ SimpleMBCompAudioProcessorEditor::SimpleMBCompAudioProcessorEditor (SimpleMBComp
     addAndMakeVisible(analyzer);
     addAndMakeVisible(globalControls);
     addAndMakeVisible(bandControls);
+    addChildComponent(spectrogramView);
+    addChildComponent(gainReductionHistoryView);
+
+    //whatever piled up while no editor was reading is stale.
+    audioProcessor.meterFrames.discardAll();
 
     setSize (550, 550);
 
-    startTimerHz(60);
+    //the meters feed the analyzer's gain reduction overlay, so they go first.
+    frameScheduler.addClient(this);
+    frameScheduler.addClient(&globalControls);
+    frameScheduler.addClient(&bandControls);
+    frameScheduler.addClient(&analyzer);
+    frameScheduler.addClient(&spectrogramView);
+    frameScheduler.start();
 }
 
 SimpleMBCompAudioProcessorEditor::~SimpleMBCompAudioProcessorEditor()
@@ -73,25 +206,77 @@ void SimpleMBCompAudioProcessorEditor::resized()
     controlBar.setBounds(bounds.removeFromTop(25));
     globalControls.setBounds(bounds.removeFromBottom(140));
     analyzer.setBounds(bounds.removeFromTop(230));
+
+    if (spectrogramView.isVisible())
+        spectrogramView.setBounds(bounds.removeFromTop(spectrogramHeight));
+
+    if (gainReductionHistoryView.isVisible())
+        gainReductionHistoryView.setBounds(bounds.removeFromTop(gainReductionHistoryHeight));
+
     bandControls.setBounds(bounds);
 }
 
-void SimpleMBCompAudioProcessorEditor::timerCallback()
+bool SimpleMBCompAudioProcessorEditor::updateFrame()
 {
-    std::vector<float> values
+    //the deepest reduction of every block since the last frame, so short transients still show.
+    std::array<float, 3> gainReduction{ 0.f, 0.f, 0.f };
+    const auto sampleRate = audioProcessor.getSampleRate();
+    auto numFrames = audioProcessor.meterFrames.pullAll([this, &gainReduction, sampleRate](const MeterFrame& frame)
+        {
+            std::array<float, 3> blockGainReduction;
+            for (size_t band = 0; band < gainReduction.size(); ++band)
+            {
+                blockGainReduction[band] = frame.bands[band].getGainReductiondB();
+                gainReduction[band] = juce::jmin(gainReduction[band], blockGainReduction[band]);
+            }
+
+            //the history scrolls with the audio, whatever rate the frames come at.
+            gainReductionHistoryView.addBlock(blockGainReduction, frame.numSamples, sampleRate);
+        });
+
+    bool changed = false;
+
+    //no blocks (transport stopped): leave the meters where they were.
+    if (numFrames > 0)
     {
-        audioProcessor.lowBandComp.getRMSInputLeveldB(),
-        audioProcessor.lowBandComp.getRMSOutputLeveldB(),
-        audioProcessor.midBandComp.getRMSInputLeveldB(),
-        audioProcessor.midBandComp.getRMSOutputLeveldB(),
-        audioProcessor.highBandComp.getRMSInputLeveldB(),
-        audioProcessor.highBandComp.getRMSOutputLeveldB()
-    };
+        changed = analyzer.update(gainReduction);
 
-    analyzer.update(values);
+        //a scrolling history is a change every frame, so the rate stays up while it's showing and audio flows.
+        changed = gainReductionHistoryView.flush() || changed;
+    }
 
     updateGlobalBypassButton();
+
+    //not counted as a change: it refreshes a few times a second and would keep the scheduler from ever idling.
+    controlBar.dspLoadDisplay.update(audioProcessor.dspLoad);
+
+    return changed;
+}
+void SimpleMBCompAudioProcessorEditor::setSpectrogramVisible(bool shouldBeVisible)
+{
+    analyzer.setSpectrogramEnabled(shouldBeVisible);
+    spectrogramView.setVisible(shouldBeVisible);
+
+    updateEditorHeight();
+}
+
+void SimpleMBCompAudioProcessorEditor::setGainReductionHistoryVisible(bool shouldBeVisible)
+{
+    gainReductionHistoryView.setVisible(shouldBeVisible);
+    updateEditorHeight();
 }
+
+void SimpleMBCompAudioProcessorEditor::updateEditorHeight()
+{
+    auto height = 550;
+    if (spectrogramView.isVisible())
+        height += spectrogramHeight;
+    if (gainReductionHistoryView.isVisible())
+        height += gainReductionHistoryHeight;
+
+    setSize(getWidth(), height);
+}
+
 void SimpleMBCompAudioProcessorEditor::updateGlobalBypassButton()
 {
     auto params = getBypassParams();
@@ -121,24 +306,12 @@ void SimpleMBCompAudioProcessorEditor::toggleGlobalBypassState()
 std::array<juce::AudioParameterBool*, 3> SimpleMBCompAudioProcessorEditor::getBypassParams()
 {
     using namespace Params;
-    using namespace juce;
-    const auto& params = Params::GetParams();
-    auto& apvts = audioProcessor.apvts;
-
-    auto boolHelper = [&apvts, &params](const auto& paramName)
-        { 
-            auto param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName))); 
-            return param;
-        };
-
-    auto* lowBypassParam = boolHelper(Names::Bypass_Low_Band);
-    auto* midBypassParam = boolHelper(Names::Bypass_Mid_Band);
-    auto* highBypassParam = boolHelper(Names::Bypass_High_Band);
+    const auto& registry = audioProcessor.paramRegistry;
 
     return
     {
-        lowBypassParam,
-        midBypassParam,
-        highBypassParam
+        registry.get<juce::AudioParameterBool>(Names::Bypass_Low_Band),
+        registry.get<juce::AudioParameterBool>(Names::Bypass_Mid_Band),
+        registry.get<juce::AudioParameterBool>(Names::Bypass_High_Band)
     };
 }
\ No newline at end of file
@@ -16,19 +16,30 @@
 #include "GUI/CompressorBandControls.h"
 #include "GUI/SpectrumAnalyzer.h"
 #include "GUI/CustomButtons.h"
+#include "GUI/FrameScheduler.h"
+#include "GUI/GainReductionHistoryView.h"
+#include "GUI/DSPLoadDisplay.h"
 
 struct ControlBar : juce::Component
 {
     ControlBar();
     void resized() override;
 
+    //resolutionComboBox ids are FFTOrders, except for this one.
+    static constexpr int multiResolutionItemId = 1;
+
     AnalyzerButton analyzerButton;
+    juce::ComboBox resolutionComboBox, overlapComboBox, averagingComboBox;
+    juce::ToggleButton peakHoldButton;
+    std::array<juce::ToggleButton, NumAnalyzerTaps> tapButtons;
+    juce::ToggleButton spectrogramButton, gainReductionHistoryButton;
+    DSPLoadDisplay dspLoadDisplay;
     PowerButton globalBypassButton;
 };
 
 //==============================================================================
 class SimpleMBCompAudioProcessorEditor  : public juce::AudioProcessorEditor,
-    juce::Timer
+    FrameScheduler::Client
 {
 public:
     SimpleMBCompAudioProcessorEditor (SimpleMBCompAudioProcessor&);
@@ -38,7 +49,7 @@ public:
     void paint (juce::Graphics&) override;
     void resized() override;
 
-    void timerCallback() override;
+    bool updateFrame() override;
 private:
     LookAndFeel lnf;
     // This reference is provided as a quick way for your editor to
@@ -49,10 +60,22 @@ private:
     GlobalControls globalControls{ audioProcessor.apvts };
     CompressorBandControls bandControls{ audioProcessor.apvts };
     SpectrumAnalyzer analyzer{ audioProcessor };
+    SpectrogramView spectrogramView{ analyzer.getSpectrogram() };
+    GainReductionHistoryView gainReductionHistoryView;
+
+    //declared last so it stops before anything it calls into is destroyed.
+    FrameScheduler frameScheduler{ *this };
 
     void toggleGlobalBypassState();
     std::array<juce::AudioParameterBool*, 3> getBypassParams();
 
     void updateGlobalBypassButton();
+    void setSpectrogramVisible(bool shouldBeVisible);
+    void setGainReductionHistoryVisible(bool shouldBeVisible);
+
+    //the optional views grow the editor underneath the analyzer rather than squeezing the band controls.
+    void updateEditorHeight();
+    static constexpr int spectrogramHeight = 100;
+    static constexpr int gainReductionHistoryHeight = 60;
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessorEditor)
 };
@@ -10,6 +10,8 @@
 #include "PluginEditor.h"
 #include "DSP/Params.h"
 #include "GUI/Utilities.h"
+#include "DSP/Profiling.h"
+#include "DSP/StateFormat.h"
 
 //==============================================================================
 SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
@@ -25,50 +27,33 @@ SimpleMBCompAudioProcessor::SimpleMBCompAudioProcessor()
 #endif
 {
     using namespace Params;
-    const auto& params = GetParams();
 
-    auto floatHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    { param = dynamic_cast<juce::AudioParameterFloat*>(apvts.getParameter(params.at(paramName))); };
-
-    auto choiceHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    { param = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(params.at(paramName))); };
-
-    auto boolHelper = [&apvts = this->apvts, &params](auto& param, const auto& paramName)
-    { param = dynamic_cast<juce::AudioParameterBool*>(apvts.getParameter(params.at(paramName))); };
-
-
-    floatHelper(lowBandComp.attack, Names::Attack_Low_band);
-    floatHelper(lowBandComp.release, Names::Release_Low_Band);
-    floatHelper(lowBandComp.threshold, Names::Threshold_Low_Band);
-
-    floatHelper(midBandComp.attack, Names::Attack_Mid_band);
-    floatHelper(midBandComp.release, Names::Release_Mid_Band);
-    floatHelper(midBandComp.threshold, Names::Threshold_Mid_Band);
-
-    floatHelper(highBandComp.attack, Names::Attack_High_band);
-    floatHelper(highBandComp.release, Names::Release_High_Band);
-    floatHelper(highBandComp.threshold, Names::Threshold_High_Band);
+    auto setupBand = [&registry = paramRegistry](CompressorBand& band,
+        Names attack, Names release, Names threshold, Names ratio, Names bypassed, Names mute, Names solo)
+        {
+            band.attack = registry.get<juce::AudioParameterFloat>(attack);
+            band.release = registry.get<juce::AudioParameterFloat>(release);
+            band.threshold = registry.get<juce::AudioParameterFloat>(threshold);
+            band.ratio = registry.get<juce::AudioParameterChoice>(ratio);
+            band.bypassed = registry.get<juce::AudioParameterBool>(bypassed);
+            band.mute = registry.get<juce::AudioParameterBool>(mute);
+            band.solo = registry.get<juce::AudioParameterBool>(solo);
+        };
 
-    choiceHelper(lowBandComp.ratio, Names::Ratio_Low_Band);
-    boolHelper(lowBandComp.bypassed, Names::Bypass_Low_Band);
-    boolHelper(lowBandComp.mute, Names::Mute_Low_Band);
-    boolHelper(lowBandComp.solo, Names::Solo_Low_Band);
+    setupBand(lowBandComp, Names::Attack_Low_band, Names::Release_Low_Band, Names::Threshold_Low_Band,
+        Names::Ratio_Low_Band, Names::Bypass_Low_Band, Names::Mute_Low_Band, Names::Solo_Low_Band);
 
-    choiceHelper(midBandComp.ratio, Names::Ratio_Mid_Band);
-    boolHelper(midBandComp.bypassed, Names::Bypass_Mid_Band);
-    boolHelper(midBandComp.mute, Names::Mute_Mid_Band);
-    boolHelper(midBandComp.solo, Names::Solo_Mid_Band);
+    setupBand(midBandComp, Names::Attack_Mid_band, Names::Release_Mid_Band, Names::Threshold_Mid_Band,
+        Names::Ratio_Mid_Band, Names::Bypass_Mid_Band, Names::Mute_Mid_Band, Names::Solo_Mid_Band);
 
-    choiceHelper(highBandComp.ratio, Names::Ratio_High_Band);
-    boolHelper(highBandComp.bypassed, Names::Bypass_High_Band);
-    boolHelper(highBandComp.mute, Names::Mute_High_Band);
-    boolHelper(highBandComp.solo, Names::Solo_High_Band);
+    setupBand(highBandComp, Names::Attack_High_band, Names::Release_High_Band, Names::Threshold_High_Band,
+        Names::Ratio_High_Band, Names::Bypass_High_Band, Names::Mute_High_Band, Names::Solo_High_Band);
 
-    floatHelper(lowMidCrossover, Names::Low_Mid_Crossover_Freq);
-    floatHelper(midHighCrossover, Names::Mid_High_Crossover_Freq);
+    lowMidCrossover = paramRegistry.get<juce::AudioParameterFloat>(Names::Low_Mid_Crossover_Freq);
+    midHighCrossover = paramRegistry.get<juce::AudioParameterFloat>(Names::Mid_High_Crossover_Freq);
 
-    floatHelper(inputGainParam, Names::Gain_In);
-    floatHelper(outputGainParam, Names::Gain_Out);
+    inputGainParam = paramRegistry.get<juce::AudioParameterFloat>(Names::Gain_In);
+    outputGainParam = paramRegistry.get<juce::AudioParameterFloat>(Names::Gain_Out);
 
     LP1.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
     LP2.setType(juce::dsp::LinkwitzRileyFilterType::lowpass);
@@ -176,14 +161,21 @@ void SimpleMBCompAudioProcessor::prepareToPlay (double sampleRate, int samplesPe
         buffer.setSize(spec.numChannels, samplesPerBlock);
     }
 
-    leftChannelFifo.prepare(samplesPerBlock);
-    rightChannelFifo.prepare(samplesPerBlock);
+    for (auto& tap : analyzerTaps)
+    {
+        tap.left.prepare(samplesPerBlock, sampleRate);
+        tap.right.prepare(samplesPerBlock, sampleRate);
+    }
 
-    osc.initialise([](float x) {return std::sin(x); });
-    osc.prepare(spec);
-    osc.setFrequency(getSampleRate() / ((2 << FFTOrder::order2048) - 1) * 50);
-    gain.prepare(spec);
-    gain.setGainDecibels(-12.f);
+    dspLoad.prepare(sampleRate);
+
+    //start at the current settings instead of ramping to them from wherever the gains were left,
+    //so a re-prepared processor renders the same audio as a new one.
+    updateState();
+    inputGain.reset();
+    outputGain.reset();
+
+    measurement.prepare(sampleRate);
 }
 
 void SimpleMBCompAudioProcessor::releaseResources()
@@ -218,6 +210,39 @@ bool SimpleMBCompAudioProcessor::isBusesLayoutSupported (const BusesLayout& layo
 }
 #endif
 
+void SimpleMBCompAudioProcessor::addAnalyzerSubscriber(AnalyzerTap tap)
+{
+    if (analyzerSubscribers[tap].fetch_add(1) == 0)
+        analyzerFifosNeedRestart[tap].store(true);
+}
+
+void SimpleMBCompAudioProcessor::removeAnalyzerSubscriber(AnalyzerTap tap)
+{
+    auto previous = analyzerSubscribers[tap].fetch_sub(1);
+    jassert(previous > 0);
+    juce::ignoreUnused(previous);
+}
+
+void SimpleMBCompAudioProcessor::feedAnalyzerTap(AnalyzerTap tap, const BlockType& source)
+{
+    if (!hasAnalyzerSubscribers(tap))
+        return;
+
+    auto& fifos = analyzerTaps[tap];
+
+    if (analyzerFifosNeedRestart[tap].exchange(false))
+    {
+        fifos.left.discardPartialBuffer();
+        fifos.right.discardPartialBuffer();
+    }
+
+    for (auto* fifo : { &fifos.left, &fifos.right })
+    {
+        if (source.getNumChannels() > fifo->getChannel())
+            fifo->update(source);
+    }
+}
+
 void SimpleMBCompAudioProcessor::updateState()
 {
     for (auto& compressor : compressors)
@@ -238,9 +263,17 @@ void SimpleMBCompAudioProcessor::updateState()
 
 void SimpleMBCompAudioProcessor::splitBands(juce::AudioBuffer<float> &inputBuffer)
 {
+    //copy-assigning would reallocate whenever the host sends a shorter block than it prepared for.
+    auto copyInto = [](juce::AudioBuffer<float>& dest, const juce::AudioBuffer<float>& source)
+    {
+        dest.setSize(source.getNumChannels(), source.getNumSamples(), false, false, true);
+        for (int ch = 0; ch < source.getNumChannels(); ++ch)
+            dest.copyFrom(ch, 0, source, ch, 0, source.getNumSamples());
+    };
+
     for (auto& fb : filterBuffers)
     {
-        fb = inputBuffer;
+        copyInto(fb, inputBuffer);
     }
 
     auto fb0Block = juce::dsp::AudioBlock<float>(filterBuffers[0]);
@@ -255,13 +288,15 @@ void SimpleMBCompAudioProcessor::splitBands(juce::AudioBuffer<float> &inputBuffe
     AP2.process(fb0Ctx);
 
     HP1.process(fb1Ctx);
-    filterBuffers[2] = filterBuffers[1];
+    copyInto(filterBuffers[2], filterBuffers[1]);
     LP2.process(fb1Ctx);
     HP2.process(fb2Ctx);
 }
 
 void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
+    PROFILE_SCOPE("processBlock");
+    DSPLoadMeter::ScopedMeasurement loadMeasurement(dspLoad, buffer.getNumSamples());
     juce::ScopedNoDenormals noDenormals;
     auto totalNumInputChannels  = getTotalNumInputChannels();
     auto totalNumOutputChannels = getTotalNumOutputChannels();
@@ -275,76 +310,125 @@ void SimpleMBCompAudioProcessor::processBlock (juce::AudioBuffer<float>& buffer,
     for (auto i = totalNumInputChannels; i < totalNumOutputChannels; ++i)
         buffer.clear (i, 0, buffer.getNumSamples());
 
-    updateState();
-
-    if (false) //testing
     {
-        buffer.clear();
-        auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto ctx = juce::dsp::ProcessContextReplacing<float>(block);
-        osc.process(ctx);
-        gain.setGainDecibels(JUCE_LIVE_CONSTANT(-12));
-        gain.process(ctx);
+        PROFILE_SCOPE("updateState");
+        updateState();
     }
 
-    leftChannelFifo.update(buffer);
-    rightChannelFifo.update(buffer);
+    //while a transfer function measurement runs its sweep replaces the input, and the output is captured and muted below.
+    const auto isMeasuring = measurement.replaceInput(buffer);
 
-    applyGain(buffer, inputGain);
-    splitBands(buffer);
+    {
+        PROFILE_SCOPE("feedAnalyzerTap input");
+        feedAnalyzerTap(InputTap, buffer);
+    }
 
-    for (size_t i = 0; i < filterBuffers.size(); ++i)
     {
-        compressors[i].process(filterBuffers[i]);
+        PROFILE_SCOPE("applyGain input");
+        applyGain(buffer, inputGain);
     }
 
-    auto numSamples  = buffer.getNumSamples();
-    auto numChannels = buffer.getNumChannels();
+    {
+        PROFILE_SCOPE("splitBands");
+        splitBands(buffer);
+    }
 
-    buffer.clear();
+    {
+        PROFILE_SCOPE("compressor low");
+        compressors[0].process(filterBuffers[0]);
+    }
+    {
+        PROFILE_SCOPE("compressor mid");
+        compressors[1].process(filterBuffers[1]);
+    }
+    {
+        PROFILE_SCOPE("compressor high");
+        compressors[2].process(filterBuffers[2]);
+    }
 
-    auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
     {
-        for (auto i = 0; i < nc; ++i)
-        {
-            inputBuffer.addFrom(i, 0, source, i, 0, ns);
-        }
-    };
+        PROFILE_SCOPE("meter frame push");
+        MeterFrame meterFrame;
+        meterFrame.numSamples = buffer.getNumSamples();
+        for (size_t i = 0; i < compressors.size(); ++i)
+            meterFrame.bands[i] = compressors[i].getLastReading();
+
+        meterFrames.push(meterFrame);
+    }
 
-    auto bandsAreSoloed = false;
-    for (auto& comp : compressors)
     {
-        if (comp.solo->get())
-        {
-            bandsAreSoloed = true;
-            break;
-        }
+        PROFILE_SCOPE("feedAnalyzerTap bands");
+        feedAnalyzerTap(LowBandTap, filterBuffers[0]);
+        feedAnalyzerTap(MidBandTap, filterBuffers[1]);
+        feedAnalyzerTap(HighBandTap, filterBuffers[2]);
     }
 
-    if (bandsAreSoloed)
     {
-        for (size_t i = 0; i < compressors.size(); ++i)
+        PROFILE_SCOPE("band summation");
+
+        auto numSamples  = buffer.getNumSamples();
+        auto numChannels = buffer.getNumChannels();
+
+        buffer.clear();
+
+        auto addFilterBand = [nc = numChannels, ns = numSamples](auto& inputBuffer, const auto& source)
+        {
+            for (auto i = 0; i < nc; ++i)
+            {
+                inputBuffer.addFrom(i, 0, source, i, 0, ns);
+            }
+        };
+
+        auto bandsAreSoloed = false;
+        for (auto& comp : compressors)
         {
-            auto& comp = compressors[i];
             if (comp.solo->get())
             {
-                addFilterBand(buffer, filterBuffers[i]);
+                bandsAreSoloed = true;
+                break;
             }
         }
-    }
-    else
-    {
-        for (size_t i = 0; i < compressors.size(); ++i)
+
+        if (bandsAreSoloed)
+        {
+            for (size_t i = 0; i < compressors.size(); ++i)
+            {
+                auto& comp = compressors[i];
+                if (comp.solo->get())
+                {
+                    addFilterBand(buffer, filterBuffers[i]);
+                }
+            }
+        }
+        else
         {
-            auto& comp = compressors[i];
-            if (!comp.mute->get())
+            for (size_t i = 0; i < compressors.size(); ++i)
             {
-                addFilterBand(buffer, filterBuffers[i]);
+                auto& comp = compressors[i];
+                if (!comp.mute->get())
+                {
+                    addFilterBand(buffer, filterBuffers[i]);
+                }
             }
         }
     }
 
-    applyGain(buffer, outputGain);
+    {
+        PROFILE_SCOPE("applyGain output");
+        applyGain(buffer, outputGain);
+    }
+
+    if (isMeasuring)
+        measurement.captureOutput(buffer);
+
+    {
+        PROFILE_SCOPE("feedAnalyzerTap output");
+        feedAnalyzerTap(OutputTap, buffer);
+    }
+
+    //the processed sweep is for the measurement only, not for the monitors or a bounce.
+    if (isMeasuring)
+        buffer.clear();
 }
 
 //==============================================================================
@@ -362,17 +446,20 @@ juce::AudioProcessorEditor* SimpleMBCompAudioProcessor::createEditor()
 //==============================================================================
 void SimpleMBCompAudioProcessor::getStateInformation (juce::MemoryBlock& destData)
 {
-    // You should use this method to store your parameters in the memory block.
-    // You could do that either as raw data, or use the XML or ValueTree classes
-    // as intermediaries to make it easy to save and load complex data.
-    juce::MemoryOutputStream mos(destData, true);
-    apvts.state.writeToStream(mos);
+    //hosts can ask for this on every undo step: a hundred bytes of parameter values, not the whole ValueTree.
+    StateFormat::write(paramRegistry, destData);
 }
 
 void SimpleMBCompAudioProcessor::setStateInformation (const void* data, int sizeInBytes)
 {
-    // You should use this method to restore your parameters from this memory block,
-    // whose contents will have been created by the getStateInformation() call.
+    //only the parameters that differ are set, so restoring the current state notifies nobody.
+    if (StateFormat::isBinaryState(data, (size_t)sizeInBytes))
+    {
+        StateFormat::restore(paramRegistry, data, (size_t)sizeInBytes);
+        return;
+    }
+
+    //sessions saved before the binary format: the whole apvts ValueTree.
     auto tree = juce::ValueTree::readFromData(data, sizeInBytes);
     if (tree.isValid())
     {
@@ -380,56 +467,52 @@ void SimpleMBCompAudioProcessor::setStateInformation (const void* data, int size
     }
 }
 
-juce::AudioProcessorValueTreeState::ParameterLayout SimpleMBCompAudioProcessor::createParameterLayout()
+juce::AudioProcessorValueTreeState::ParameterLayout SimpleMBCompAudioProcessor::createParameterLayout(Params::Registry& registry)
 {
     APVTS::ParameterLayout layout;
     using namespace juce;
     using namespace Params;
-    const auto& params = GetParams();
 
-    auto choices = std::vector<double>{ 1, 1.5, 2, 3, 4, 5, 6, 7, 8, 10, 15, 20, 25, 50, 100 };
-    juce::StringArray sa;
-    for (auto choice : choices)
-        sa.add(juce::String(choice, 1));
+    const auto& ratioChoices = GetRatioChoiceNames();
 
     auto gainRange = NormalisableRange<float>(-24.f, 24.f, 0.5f, 1.f);
     auto thresholdRange = NormalisableRange<float>(MIN_THRESHOLD, MAX_DECIBELS, 1, 1);
     auto attackRange = NormalisableRange<float>(5, 500, 1, 1);
     auto releaseRange = NormalisableRange<float>(5, 500, 1, 1) ;
 
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Gain_In), params.at(Names::Gain_In), gainRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Gain_Out), params.at(Names::Gain_Out), gainRange, 0));
+    registry.add<AudioParameterFloat>(layout, Names::Gain_In, gainRange, 0);
+    registry.add<AudioParameterFloat>(layout, Names::Gain_Out, gainRange, 0);
+
+    registry.add<AudioParameterFloat>(layout, Names::Threshold_Low_Band, thresholdRange, 0);
+    registry.add<AudioParameterFloat>(layout, Names::Threshold_Mid_Band, thresholdRange, 0);
+    registry.add<AudioParameterFloat>(layout, Names::Threshold_High_Band, thresholdRange, 0);
 
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_Low_Band), params.at(Names::Threshold_Low_Band), thresholdRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_Mid_Band), params.at(Names::Threshold_Mid_Band), thresholdRange, 0));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Threshold_High_Band), params.at(Names::Threshold_High_Band), thresholdRange, 0));
-  
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_Low_band), params.at(Names::Attack_Low_band), attackRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_Mid_band), params.at(Names::Attack_Mid_band), attackRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Attack_High_band), params.at(Names::Attack_High_band), attackRange, 50));
+    registry.add<AudioParameterFloat>(layout, Names::Attack_Low_band, attackRange, 50);
+    registry.add<AudioParameterFloat>(layout, Names::Attack_Mid_band, attackRange, 50);
+    registry.add<AudioParameterFloat>(layout, Names::Attack_High_band, attackRange, 50);
 
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_Low_Band), params.at(Names::Release_Low_Band), releaseRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_Mid_Band), params.at(Names::Release_Mid_Band), releaseRange, 50));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Release_High_Band), params.at(Names::Release_High_Band), releaseRange, 50));
+    registry.add<AudioParameterFloat>(layout, Names::Release_Low_Band, releaseRange, 50);
+    registry.add<AudioParameterFloat>(layout, Names::Release_Mid_Band, releaseRange, 50);
+    registry.add<AudioParameterFloat>(layout, Names::Release_High_Band, releaseRange, 50);
 
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_Low_Band), params.at(Names::Ratio_Low_Band), sa, 3));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_Mid_Band), params.at(Names::Ratio_Mid_Band), sa, 3));
-    layout.add(std::make_unique<AudioParameterChoice>(params.at(Names::Ratio_High_Band), params.at(Names::Ratio_High_Band), sa, 3));
+    registry.add<AudioParameterChoice>(layout, Names::Ratio_Low_Band, ratioChoices, 3);
+    registry.add<AudioParameterChoice>(layout, Names::Ratio_Mid_Band, ratioChoices, 3);
+    registry.add<AudioParameterChoice>(layout, Names::Ratio_High_Band, ratioChoices, 3);
 
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypass_Low_Band), params.at(Names::Bypass_Low_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypass_Mid_Band), params.at(Names::Bypass_Mid_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Bypass_High_Band), params.at(Names::Bypass_High_Band), false));
+    registry.add<AudioParameterBool>(layout, Names::Bypass_Low_Band, false);
+    registry.add<AudioParameterBool>(layout, Names::Bypass_Mid_Band, false);
+    registry.add<AudioParameterBool>(layout, Names::Bypass_High_Band, false);
 
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_Low_Band), params.at(Names::Mute_Low_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_Mid_Band), params.at(Names::Mute_Mid_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Mute_High_Band), params.at(Names::Mute_High_Band), false));
+    registry.add<AudioParameterBool>(layout, Names::Mute_Low_Band, false);
+    registry.add<AudioParameterBool>(layout, Names::Mute_Mid_Band, false);
+    registry.add<AudioParameterBool>(layout, Names::Mute_High_Band, false);
 
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_Low_Band), params.at(Names::Solo_Low_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_Mid_Band), params.at(Names::Solo_Mid_Band), false));
-    layout.add(std::make_unique<AudioParameterBool>(params.at(Names::Solo_High_Band), params.at(Names::Solo_High_Band), false));
+    registry.add<AudioParameterBool>(layout, Names::Solo_Low_Band, false);
+    registry.add<AudioParameterBool>(layout, Names::Solo_Mid_Band, false);
+    registry.add<AudioParameterBool>(layout, Names::Solo_High_Band, false);
 
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Low_Mid_Crossover_Freq), params.at(Names::Low_Mid_Crossover_Freq), NormalisableRange<float>(MIN_FREQUENCY, 999, 1, 1), 200));
-    layout.add(std::make_unique<AudioParameterFloat>(params.at(Names::Mid_High_Crossover_Freq), params.at(Names::Mid_High_Crossover_Freq), NormalisableRange<float>(1000, MAX_FREQUENCY, 1, 1), 2000));
+    registry.add<AudioParameterFloat>(layout, Names::Low_Mid_Crossover_Freq, NormalisableRange<float>(MIN_FREQUENCY, 999, 1, 1), 200);
+    registry.add<AudioParameterFloat>(layout, Names::Mid_High_Crossover_Freq, NormalisableRange<float>(1000, MAX_FREQUENCY, 1, 1), 2000);
 
     return layout;
 }
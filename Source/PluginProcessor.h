@@ -10,7 +10,10 @@
 
 #include <JuceHeader.h>
 #include "DSP/CompressorBand.h"
+#include "DSP/Params.h"
 #include "DSP/SingleChannelSampleFifo.h"
+#include "DSP/DSPLoadMeter.h"
+#include "DSP/TransferFunctionMeasurement.h"
 
 //==============================================================================
 /**
@@ -56,13 +59,39 @@ public:
     void setStateInformation (const void* data, int sizeInBytes) override;
 
     using APVTS = juce::AudioProcessorValueTreeState;
-    static APVTS::ParameterLayout createParameterLayout();
+    static APVTS::ParameterLayout createParameterLayout(Params::Registry& registry);
 
-    APVTS apvts {*this, nullptr, "Parameters", createParameterLayout() };
+    //filled in by createParameterLayout(), so it has to be declared before apvts.
+    Params::Registry paramRegistry;
+    APVTS apvts {*this, nullptr, "Parameters", createParameterLayout(paramRegistry) };
 
     using BlockType = juce::AudioBuffer<float>;
-    SingleChannelSampleFifo<BlockType> leftChannelFifo{ Channel::Left };
-    SingleChannelSampleFifo<BlockType> rightChannelFifo{ Channel::Right };
+    struct AnalyzerTapFifos
+    {
+        SingleChannelSampleFifo<BlockType> left{ Channel::Left };
+        SingleChannelSampleFifo<BlockType> right{ Channel::Right };
+    };
+
+    std::array<AnalyzerTapFifos, NumAnalyzerTaps> analyzerTaps;
+
+    //every block's per-band levels, for meters that shouldn't miss anything between editor frames.
+    MeterFrameRing meterFrames;
+
+    //how much of each block's deadline processBlock() takes, for the control bar's load display.
+    DSPLoadMeter dspLoad;
+
+    //sweeps the whole chain, for checking the crossover sums flat. see TransferFunctionMeasurement.
+    TransferFunctionMeasurement measurement;
+
+    /*
+     a tap's fifos are only fed while something is subscribed to that tap.
+     the first subscriber after a pause gets a fresh stream, not stale audio.
+     only the analyzer reads the taps. the editor's meters and gain reduction history come from
+     meterFrames, which is pushed every block and isn't gated by subscriptions.
+     */
+    void addAnalyzerSubscriber(AnalyzerTap tap);
+    void removeAnalyzerSubscriber(AnalyzerTap tap);
+    bool hasAnalyzerSubscribers(AnalyzerTap tap) const { return analyzerSubscribers[tap].load(std::memory_order_relaxed) > 0; }
 
     std::array<CompressorBand, 3> compressors;
     CompressorBand& lowBandComp  = compressors[0];
@@ -96,8 +125,10 @@ private:
     void updateState();
     void splitBands(juce::AudioBuffer<float>& inputBuffer);
 
-    juce::dsp::Oscillator<float> osc;
-    juce::dsp::Gain<float> gain;
+    std::array<std::atomic<int>, NumAnalyzerTaps> analyzerSubscribers{};
+    std::array<std::atomic<bool>, NumAnalyzerTaps> analyzerFifosNeedRestart{};
+
+    void feedAnalyzerTap(AnalyzerTap tap, const BlockType& source);
     //==============================================================================
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SimpleMBCompAudioProcessor)
 };
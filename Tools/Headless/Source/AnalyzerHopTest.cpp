@@ -0,0 +1,123 @@
+/*
+  ==============================================================================
+
+    AnalyzerHopTest.cpp
+    Created: 20 Oct 2026 9:12:40am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "AnalyzerHopTest.h"
+#include "../../../Source/GUI/PathProducer.h"
+
+namespace
+{
+using BlockType = SimpleMBCompAudioProcessor::BlockType;
+
+//the first plan is built in the background and installed by process().
+bool waitForPlan(PathProducer& producer, juce::Rectangle<float> bounds, double sampleRate)
+{
+    for (int attempt = 0; attempt < 5000 && producer.getHopSize() == 0; ++attempt)
+    {
+        producer.process(bounds, sampleRate);
+        juce::Thread::sleep(1);
+    }
+
+    return producer.getHopSize() > 0;
+}
+
+juce::var runCase(FFTOrder order, bool multiResolution, int overlap, int blockSize, int numSamples)
+{
+    constexpr double sampleRate = 48000.0;
+    const juce::Rectangle<float> bounds{ 0.f, 0.f, 550.f, 230.f };
+
+    SingleChannelSampleFifo<BlockType> fifo{ Channel::Left };
+    fifo.prepare(blockSize, sampleRate);
+
+    PathProducer producer{ fifo, order };
+    producer.setOverlap(overlap);
+    producer.setMultiResolutionEnabled(multiResolution);
+
+    auto* result = new juce::DynamicObject();
+    result->setProperty("fftSize", multiResolution ? juce::var("multiResolution") : juce::var(1 << order));
+    result->setProperty("overlap", overlap);
+    result->setProperty("blockSize", blockSize);
+    result->setProperty("samples", numSamples);
+
+    if (!waitForPlan(producer, bounds, sampleRate))
+    {
+        result->setProperty("error", "the FFT plan was never built");
+        result->setProperty("passed", false);
+        return juce::var(result);
+    }
+
+    producer.flush();
+
+    juce::AudioBuffer<float> block(2, blockSize);
+    juce::Random random(1234);
+
+    for (int start = 0; start < numSamples; start += blockSize)
+    {
+        for (int i = 0; i < blockSize; ++i)
+            block.setSample(Channel::Left, i, random.nextFloat() * 2.f - 1.f);
+
+        fifo.update(block);
+
+        //one editor frame every few blocks, so several hops pile up between reads.
+        if ((start / blockSize) % 4 == 3)
+            producer.process(bounds, sampleRate);
+    }
+
+    //the fifo only hands a buffer over once the next one starts.
+    juce::AudioBuffer<float> oneMore(2, 1);
+    oneMore.clear();
+    fifo.update(oneMore);
+    producer.process(bounds, sampleRate);
+
+    auto hopSize = producer.getHopSize();
+    auto samplesDelivered = (numSamples / blockSize) * blockSize;
+    auto expected = samplesDelivered / hopSize;
+    auto analyzed = producer.getNumFramesAnalyzed();
+
+    result->setProperty("hopSize", hopSize);
+    result->setProperty("expectedFrames", expected);
+    result->setProperty("analyzedFrames", analyzed);
+    result->setProperty("passed", analyzed == expected);
+    return juce::var(result);
+}
+}
+
+juce::var runAnalyzerHopTest()
+{
+    //enough that the longest FFT at 1x still gets a few hops.
+    constexpr int numSamples = 48000 * 2;
+
+    juce::Array<juce::var> cases;
+    bool allPassed = true;
+
+    for (auto multiResolution : { false, true })
+    {
+        for (auto order : { FFTOrder::order2048, FFTOrder::order8192 })
+        {
+            //the cascade always hops like the 8192 point analyzer.
+            if (multiResolution && order != FFTOrder::order8192)
+                continue;
+
+            for (auto overlap : { 1, 4, 8 })
+            {
+                for (auto blockSize : { 64, 512, 4096 })
+                {
+                    auto result = runCase(order, multiResolution, overlap, blockSize, numSamples);
+                    allPassed = allPassed && (bool)result["passed"];
+                    cases.add(result);
+                }
+            }
+        }
+    }
+
+    auto* results = new juce::DynamicObject();
+    results->setProperty("cases", cases);
+    results->setProperty("passed", allPassed);
+    return juce::var(results);
+}
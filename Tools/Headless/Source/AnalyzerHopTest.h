@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    AnalyzerHopTest.h
+    Created: 20 Oct 2026 9:12:40am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ feeds a PathProducer N samples through a SingleChannelSampleFifo at several FFT sizes
+ (and with the multi-resolution cascade), overlaps and host block sizes, and checks it analyzed floor(N / hop) frames: one per hop,
+ however many hops a block spans. 'passed' is false if any case was off.
+ */
+juce::var runAnalyzerHopTest();
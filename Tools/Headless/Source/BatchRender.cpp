@@ -0,0 +1,333 @@
+/*
+  ==============================================================================
+
+    BatchRender.cpp
+    Created: 19 Oct 2026 11:52:36pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "BatchRender.h"
+#include "ProcessorHarness.h"
+#include "../../../Source/DSP/StateFormat.h"
+#include <map>
+
+namespace
+{
+const juce::StringArray supportedExtensions{ ".wav", ".flac", ".aif", ".aiff" };
+
+struct RenderJob
+{
+    juce::File input, output;
+
+    //filled in by whichever worker renders it.
+    juce::String error;
+    double sampleRate = 0.0;
+    juce::int64 numSamples = 0;
+    int numChannels = 0;
+    double renderSeconds = 0.0;
+};
+
+bool loadState(const juce::File& file, juce::MemoryBlock& state, juce::String& error)
+{
+    if (file == juce::File())
+        return true;
+
+    if (!file.existsAsFile())
+    {
+        error = "state file not found: " + file.getFullPathName();
+        return false;
+    }
+
+    //a preset is the parameter tree as XML: turn it into the ValueTree state setStateInformation() still reads.
+    if (auto xml = juce::parseXML(file))
+    {
+        auto tree = juce::ValueTree::fromXml(*xml);
+        if (!tree.isValid())
+        {
+            error = "not a preset: " + file.getFullPathName();
+            return false;
+        }
+
+        juce::MemoryOutputStream mos(state, false);
+        tree.writeToStream(mos);
+        return true;
+    }
+
+    if (!file.loadFileAsData(state)
+        || !(StateFormat::isBinaryState(state.getData(), state.getSize())
+             || juce::ValueTree::readFromData(state.getData(), state.getSize()).isValid()))
+    {
+        error = "not a state blob or preset: " + file.getFullPathName();
+        return false;
+    }
+
+    return true;
+}
+
+juce::Array<juce::File> findInputFiles(const juce::Array<juce::File>& inputs)
+{
+    juce::Array<juce::File> files;
+
+    for (const auto& input : inputs)
+    {
+        if (input.isDirectory())
+        {
+            auto found = input.findChildFiles(juce::File::findFiles, true, "*.wav;*.flac;*.aif;*.aiff");
+
+            //the file system's order isn't stable, and the job list should be.
+            found.sort();
+            files.addArray(found);
+        }
+        else
+        {
+            files.add(input);
+        }
+    }
+
+    return files;
+}
+
+juce::AudioFormat* findOutputFormat(juce::AudioFormatManager& formats, const juce::String& outputFormat, const juce::File& input)
+{
+    auto extension = outputFormat.isNotEmpty() ? "." + outputFormat : input.getFileExtension();
+    return formats.findFormatForFileExtension(extension);
+}
+
+struct RenderWorker : juce::Thread
+{
+    RenderWorker(int index, std::vector<RenderJob>& jobsToRender, std::atomic<int>& nextJobIndex,
+                 juce::TimeSliceThread& readAheadThread, const BatchRenderOptions& renderOptions) :
+        juce::Thread("render worker " + juce::String(index)),
+        jobs(jobsToRender),
+        nextJob(nextJobIndex),
+        readAhead(readAheadThread),
+        options(renderOptions)
+    {
+        formats.registerBasicFormats();
+    }
+
+    //the processor is created and given its state on the message thread, before the workers start.
+    SimpleMBCompAudioProcessor processor;
+
+    void run() override
+    {
+        for (auto index = nextJob.fetch_add(1); index < (int)jobs.size(); index = nextJob.fetch_add(1))
+        {
+            auto& job = jobs[(size_t)index];
+            auto start = juce::Time::getHighResolutionTicks();
+            job.error = render(job);
+            job.renderSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+
+            if (threadShouldExit())
+                return;
+        }
+    }
+private:
+    std::vector<RenderJob>& jobs;
+    std::atomic<int>& nextJob;
+    juce::TimeSliceThread& readAhead;
+    const BatchRenderOptions& options;
+    juce::AudioFormatManager formats;
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+
+    juce::String render(RenderJob& job)
+    {
+        std::unique_ptr<juce::AudioFormatReader> fileReader(formats.createReaderFor(job.input));
+        if (fileReader == nullptr)
+            return "can't read " + job.input.getFullPathName();
+
+        job.sampleRate = fileReader->sampleRate;
+        job.numSamples = fileReader->lengthInSamples;
+        job.numChannels = (int)fileReader->numChannels;
+
+        if (job.numChannels < 1 || job.numChannels > 2)
+            return "only mono and stereo files are supported";
+
+        auto* format = findOutputFormat(formats, options.outputFormat, job.input);
+        if (format == nullptr)
+            return "unknown output format";
+
+        //keep the input's bit depth where the output format can hold it.
+        auto bitDepth = (int)fileReader->bitsPerSample;
+        if (!format->getPossibleBitDepths().contains(bitDepth))
+            bitDepth = format->getPossibleBitDepths().getLast();
+
+        //decoding runs on the read-ahead thread. readSamples() waits for it rather than returning silence.
+        juce::BufferingAudioReader reader(fileReader.release(), readAhead, options.readAheadSamples);
+        reader.setReadTimeout(-1);
+
+        job.output.deleteFile();
+        auto stream = job.output.createOutputStream();
+        if (stream == nullptr)
+            return "can't write " + job.output.getFullPathName();
+
+        std::unique_ptr<juce::AudioFormatWriter> writer(format->createWriterFor(stream.get(), job.sampleRate, (unsigned int)job.numChannels,
+                                                                                bitDepth, {}, 0));
+        if (writer == nullptr)
+            return "can't write " + format->getFormatName() + " at " + juce::String(bitDepth) + " bits";
+
+        //the writer owns the stream now.
+        stream.release();
+
+        if (!prepareProcessor(processor, job.sampleRate, options.blockSize, job.numChannels))
+            return "the processor refused a " + juce::String(job.numChannels) + " channel layout";
+
+        buffer.setSize(job.numChannels, options.blockSize);
+
+        for (juce::int64 position = 0; position < job.numSamples; position += options.blockSize)
+        {
+            auto numSamples = (int)juce::jmin((juce::int64)options.blockSize, job.numSamples - position);
+
+            //the last block is shorter: hand processBlock a buffer of exactly that length, like a host would.
+            juce::AudioBuffer<float> block(buffer.getArrayOfWritePointers(), job.numChannels, numSamples);
+            reader.read(&block, 0, numSamples, position, true, true);
+
+            processor.processBlock(block, midi);
+
+            if (!writer->writeFromAudioSampleBuffer(block, 0, numSamples))
+                return "write failed: " + job.output.getFullPathName();
+
+            if (threadShouldExit())
+                return "cancelled";
+        }
+
+        processor.releaseResources();
+        return {};
+    }
+};
+}
+
+juce::var runBatchRender(const BatchRenderOptions& options)
+{
+    auto* result = new juce::DynamicObject();
+    juce::var resultVar(result);
+
+    juce::MemoryBlock state;
+    juce::String error;
+    if (!loadState(options.stateFile, state, error))
+    {
+        result->setProperty("error", error);
+        return resultVar;
+    }
+
+    if (!options.outputDirectory.createDirectory())
+    {
+        result->setProperty("error", "can't create " + options.outputDirectory.getFullPathName());
+        return resultVar;
+    }
+
+    //outputs are decided up front, in input order, so they don't depend on which worker finishes first.
+    std::vector<RenderJob> jobs;
+    std::map<juce::String, juce::String> outputsSoFar;
+    juce::AudioFormatManager formats;
+    formats.registerBasicFormats();
+
+    for (const auto& input : findInputFiles(options.inputs))
+    {
+        RenderJob job;
+        job.input = input;
+
+        if (!supportedExtensions.contains(input.getFileExtension(), true))
+        {
+            job.error = "unsupported file type";
+        }
+        else if (auto* format = findOutputFormat(formats, options.outputFormat, input))
+        {
+            job.output = options.outputDirectory.getChildFile(input.getFileNameWithoutExtension())
+                                                .withFileExtension(format->getFileExtensions()[0]);
+
+            auto [existing, inserted] = outputsSoFar.emplace(job.output.getFullPathName(), input.getFullPathName());
+            if (!inserted)
+                job.error = "same output name as " + existing->second;
+        }
+        else
+        {
+            job.error = "unknown output format '" + options.outputFormat + "'";
+        }
+
+        jobs.push_back(job);
+    }
+
+    //only jobs without an error so far get rendered.
+    std::vector<RenderJob> toRender;
+    std::vector<size_t> toRenderIndices;
+    for (size_t i = 0; i < jobs.size(); ++i)
+    {
+        if (jobs[i].error.isEmpty())
+        {
+            toRender.push_back(jobs[i]);
+            toRenderIndices.push_back(i);
+        }
+    }
+
+    juce::TimeSliceThread readAhead("render read-ahead");
+    readAhead.startThread();
+
+    std::atomic<int> nextJob{ 0 };
+    std::vector<std::unique_ptr<RenderWorker>> workers;
+    const auto numWorkers = juce::jlimit(1, juce::jmax(1, (int)toRender.size()), options.numWorkers);
+
+    for (int i = 0; i < numWorkers; ++i)
+    {
+        auto worker = std::make_unique<RenderWorker>(i, toRender, nextJob, readAhead, options);
+        if (state.getSize() > 0)
+            worker->processor.setStateInformation(state.getData(), (int)state.getSize());
+
+        workers.push_back(std::move(worker));
+    }
+
+    auto start = juce::Time::getHighResolutionTicks();
+
+    for (auto& worker : workers)
+        worker->startThread();
+
+    for (auto& worker : workers)
+        worker->waitForThreadToExit(-1);
+
+    auto wallSeconds = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start);
+    readAhead.stopThread(1000);
+
+    for (size_t i = 0; i < toRender.size(); ++i)
+        jobs[toRenderIndices[i]] = toRender[i];
+
+    juce::Array<juce::var> files;
+    double audioSeconds = 0.0;
+    int numFailed = 0;
+
+    for (const auto& job : jobs)
+    {
+        auto* file = new juce::DynamicObject();
+        file->setProperty("input", job.input.getFullPathName());
+
+        if (job.error.isNotEmpty())
+        {
+            file->setProperty("error", job.error);
+            ++numFailed;
+        }
+        else
+        {
+            const auto seconds = job.numSamples / job.sampleRate;
+            audioSeconds += seconds;
+
+            file->setProperty("output", job.output.getFullPathName());
+            file->setProperty("sampleRate", job.sampleRate);
+            file->setProperty("channels", job.numChannels);
+            file->setProperty("seconds", seconds);
+            file->setProperty("realTimeFactor", job.renderSeconds > 0.0 ? seconds / job.renderSeconds : 0.0);
+        }
+
+        files.add(juce::var(file));
+    }
+
+    result->setProperty("workers", numWorkers);
+    result->setProperty("blockSize", options.blockSize);
+    result->setProperty("files", files);
+    result->setProperty("failed", numFailed);
+    result->setProperty("audioSeconds", audioSeconds);
+    result->setProperty("wallSeconds", wallSeconds);
+    result->setProperty("realTimeFactor", wallSeconds > 0.0 ? audioSeconds / wallSeconds : 0.0);
+    return resultVar;
+}
@@ -0,0 +1,42 @@
+/*
+  ==============================================================================
+
+    BatchRender.h
+    Created: 19 Oct 2026 11:52:36pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+struct BatchRenderOptions
+{
+    //getStateInformation() output, or a preset (the parameter state as XML). empty renders with the defaults.
+    juce::File stateFile;
+
+    //files, or directories searched recursively for .wav, .flac, .aif and .aiff.
+    juce::Array<juce::File> inputs;
+
+    //each input is written here under its own name. created if it doesn't exist.
+    juce::File outputDirectory;
+
+    //"wav", "flac" or "aiff". empty keeps each input's format.
+    juce::String outputFormat;
+
+    int numWorkers = juce::SystemStats::getNumCpus();
+    int blockSize = 8192;
+
+    //samples per channel the read-ahead thread keeps decoded ahead of each worker.
+    int readAheadSamples = 1 << 18;
+};
+
+/*
+ renders every input through a SimpleMBCompAudioProcessor with the given state, 'numWorkers'
+ files at a time. each worker owns one processor and prepares it again before every file, so
+ a file renders the same whichever worker picks it up, and the output doesn't depend on the
+ number of workers.
+ returns per-file results (in input order) and the overall real-time factor.
+ */
+juce::var runBatchRender(const BatchRenderOptions& options);
@@ -0,0 +1,87 @@
+/*
+  ==============================================================================
+
+    BenchmarkUtilities.h
+    Created: 19 Oct 2026 9:40:18am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include <algorithm>
+#include <vector>
+
+struct BenchmarkStats
+{
+    int iterations = 0;
+    double meanNs = 0.0;
+    double p50Ns = 0.0;
+    double p99Ns = 0.0;
+    double maxNs = 0.0;
+};
+
+inline double ticksToNanoseconds(juce::int64 ticks)
+{
+    return static_cast<double>(ticks) * 1.0e9 / static_cast<double>(juce::Time::getHighResolutionTicksPerSecond());
+}
+
+inline BenchmarkStats computeStats(std::vector<double>& timingsNs)
+{
+    BenchmarkStats stats;
+    if (timingsNs.empty())
+        return stats;
+
+    std::sort(timingsNs.begin(), timingsNs.end());
+
+    auto percentile = [&timingsNs](double p)
+    {
+        auto index = static_cast<size_t>(p * static_cast<double>(timingsNs.size() - 1));
+        return timingsNs[index];
+    };
+
+    double total = 0.0;
+    for (auto t : timingsNs)
+        total += t;
+
+    stats.iterations = static_cast<int>(timingsNs.size());
+    stats.meanNs = total / static_cast<double>(timingsNs.size());
+    stats.p50Ns = percentile(0.5);
+    stats.p99Ns = percentile(0.99);
+    stats.maxNs = timingsNs.back();
+    return stats;
+}
+
+/*
+ calls 'fn' 'warmup' times untimed, then 'iterations' times timed.
+ */
+template<typename Fn>
+BenchmarkStats runBenchmark(int iterations, int warmup, Fn&& fn)
+{
+    for (int i = 0; i < warmup; ++i)
+        fn();
+
+    std::vector<double> timingsNs;
+    timingsNs.reserve(static_cast<size_t>(iterations));
+
+    for (int i = 0; i < iterations; ++i)
+    {
+        auto start = juce::Time::getHighResolutionTicks();
+        fn();
+        timingsNs.push_back(ticksToNanoseconds(juce::Time::getHighResolutionTicks() - start));
+    }
+
+    return computeStats(timingsNs);
+}
+
+inline juce::var toVar(const BenchmarkStats& stats)
+{
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("iterations", stats.iterations);
+    obj->setProperty("meanNs", stats.meanNs);
+    obj->setProperty("p50Ns", stats.p50Ns);
+    obj->setProperty("p99Ns", stats.p99Ns);
+    obj->setProperty("maxNs", stats.maxNs);
+    return juce::var(obj);
+}
@@ -0,0 +1,206 @@
+/*
+  ==============================================================================
+
+    FFTBenchmark.cpp
+    Created: 19 Oct 2026 9:41:02am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "FFTBenchmark.h"
+#include "BenchmarkUtilities.h"
+#include "../../../Source/GUI/FFTDataGenerator.h"
+#include "../../../Source/GUI/FastDecibels.h"
+#include "../../../Source/GUI/MultiResolutionFFTDataGenerator.h"
+
+namespace
+{
+juce::String getOrderName(FFTOrder order)
+{
+    return "order" + juce::String(1 << order);
+}
+
+void fillWithNoise(juce::AudioBuffer<float>& buffer)
+{
+    juce::Random r(1234);
+    for (int i = 0; i < buffer.getNumSamples(); ++i)
+        buffer.setSample(0, i, r.nextFloat() * 2.f - 1.f);
+}
+
+/*
+ what the cascade is measured against: one window of 2^order points, analyzed every hop
+ the same way a cascade stage is.
+ */
+struct SingleResolutionAnalyzer
+{
+    explicit SingleResolutionAnalyzer(int order) :
+        fftSize(1 << order),
+        forwardFFT(order),
+        window((size_t)fftSize, juce::dsp::WindowingFunction<float>::blackmanHarris),
+        history((size_t)fftSize, 0.f),
+        scratch((size_t)fftSize * 2, 0.f)
+    {
+    }
+
+    //returns how many frames were made.
+    int pushSamples(const float* samples, int numSamples, int hopSize, float negativeInfinity)
+    {
+        int numFrames = 0;
+        while (numSamples > 0)
+        {
+            auto size = juce::jmin(numSamples, hopSize - samplesSinceLastFFT);
+            std::copy(history.begin() + size, history.end(), history.begin());
+            std::copy(samples, samples + size, history.end() - size);
+
+            samples += size;
+            numSamples -= size;
+            samplesSinceLastFFT += size;
+
+            if (samplesSinceLastFFT >= hopSize)
+            {
+                samplesSinceLastFFT -= hopSize;
+
+                std::copy(history.begin(), history.end(), scratch.begin());
+                window.multiplyWithWindowingTable(scratch.data(), (size_t)fftSize);
+                forwardFFT.performFrequencyOnlyForwardTransform(scratch.data());
+                convertMagnitudesToDecibels(scratch.data(), fftSize / 2, 1.f / float(fftSize / 2), negativeInfinity);
+                ++numFrames;
+            }
+        }
+
+        return numFrames;
+    }
+
+    int fftSize;
+    juce::dsp::FFT forwardFFT;
+    juce::dsp::WindowingFunction<float> window;
+    std::vector<float> history, scratch;
+    int samplesSinceLastFFT = 0;
+};
+}
+
+juce::var runFFTBenchmark(int iterations)
+{
+    const float negativeInfinity = NEGATIVE_INFINITY;
+    const auto warmup = juce::jmax(1, iterations / 10);
+
+    auto* results = new juce::DynamicObject();
+
+    for (auto order : { FFTOrder::order2048, FFTOrder::order4096, FFTOrder::order8192, FFTOrder::order16384 })
+    {
+        FFTDataGenerator<std::vector<float>> generator;
+        generator.changeOrder(order);
+
+        while (!generator.installPendingPlan())
+            juce::Thread::sleep(1);
+
+        const auto fftSize = generator.getFFTSize();
+        const auto numBins = fftSize / 2;
+
+        juce::AudioBuffer<float> audio(1, fftSize);
+        fillWithNoise(audio);
+
+        std::vector<float> pulled;
+        auto produce = runBenchmark(iterations, warmup, [&]()
+        {
+            generator.produceFFTDataForRendering(audio, negativeInfinity);
+            generator.getFFTData(pulled);
+        });
+
+        // the dB stage on its own, fed with magnitude-like data.
+        std::vector<float> magnitudes(static_cast<size_t>(numBins));
+        juce::Random r(5678);
+        for (auto& m : magnitudes)
+            m = r.nextFloat() * static_cast<float>(numBins);
+
+        std::vector<float> scratch(magnitudes.size());
+
+        auto fast = runBenchmark(iterations, warmup, [&]()
+        {
+            std::copy(magnitudes.begin(), magnitudes.end(), scratch.begin());
+            convertMagnitudesToDecibels(scratch.data(), numBins, 1.f / float(numBins), negativeInfinity);
+        });
+
+        auto reference = runBenchmark(iterations, warmup, [&]()
+        {
+            std::copy(magnitudes.begin(), magnitudes.end(), scratch.begin());
+            for (auto& v : scratch)
+                v = juce::Decibels::gainToDecibels(v / float(numBins), negativeInfinity);
+        });
+
+        auto* entry = new juce::DynamicObject();
+        entry->setProperty("fftSize", fftSize);
+        entry->setProperty("produceFFTDataForRendering", toVar(produce));
+        entry->setProperty("convertMagnitudesToDecibels", toVar(fast));
+        entry->setProperty("gainToDecibelsReference", toVar(reference));
+
+        results->setProperty(getOrderName(order), juce::var(entry));
+    }
+
+    /*
+     one second of audio at 48kHz in 512 sample blocks, all at the 8x overlap cadence of the
+     8192 point analyzer so every side makes the same frames per second. the cascade against
+     an 8192 point FFT (its top stage's resolution) and a 65536 point one (its lowest stage's).
+     */
+    {
+        constexpr double sampleRate = 48000.0;
+        constexpr int blockSize = 512;
+        constexpr int hopSize = (1 << FFTOrder::order8192) / 8;
+        const auto multiResolutionIterations = juce::jmax(1, iterations / 100);
+
+        juce::AudioBuffer<float> second(1, int(sampleRate));
+        fillWithNoise(second);
+
+        auto* entry = new juce::DynamicObject();
+
+        auto benchmarkSingle = [&](int order)
+            {
+                SingleResolutionAnalyzer analyzer{ order };
+                int frames = 0;
+
+                auto stats = runBenchmark(multiResolutionIterations, 1, [&]()
+                {
+                    frames = 0;
+                    for (int start = 0; start + blockSize <= second.getNumSamples(); start += blockSize)
+                        frames += analyzer.pushSamples(second.getReadPointer(0, start), blockSize, hopSize, negativeInfinity);
+                });
+
+                auto* single = new juce::DynamicObject();
+                single->setProperty("perSecondOfAudio", toVar(stats));
+                single->setProperty("framesPerSecondOfAudio", frames);
+                entry->setProperty("order" + juce::String(1 << order), juce::var(single));
+            };
+
+        benchmarkSingle(FFTOrder::order8192);
+        //past FFTOrder: the lowest stage's bins are fs / 32 / 2048 wide.
+        constexpr int order65536 = 16;
+        benchmarkSingle(order65536);
+
+        MultiResolutionFFTDataGenerator multiResolution;
+        multiResolution.prepare(sampleRate);
+        multiResolution.setHopSize(hopSize);
+
+        std::vector<float> pulled;
+        int frames = 0;
+
+        auto cascade = runBenchmark(multiResolutionIterations, 1, [&]()
+        {
+            frames = 0;
+            for (int start = 0; start + blockSize <= second.getNumSamples(); start += blockSize)
+            {
+                frames += multiResolution.pushSamples(second.getReadPointer(0, start), blockSize, negativeInfinity);
+                while (multiResolution.getFFTData(pulled)) { }
+            }
+        });
+
+        auto* multi = new juce::DynamicObject();
+        multi->setProperty("perSecondOfAudio", toVar(cascade));
+        multi->setProperty("framesPerSecondOfAudio", frames);
+        entry->setProperty("multiResolution", juce::var(multi));
+
+        results->setProperty("multiResolution", juce::var(entry));
+    }
+
+    return juce::var(results);
+}
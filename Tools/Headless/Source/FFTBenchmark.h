@@ -0,0 +1,20 @@
+/*
+  ==============================================================================
+
+    FFTBenchmark.h
+    Created: 19 Oct 2026 9:41:02am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ times FFTDataGenerator::produceFFTDataForRendering for every FFTOrder,
+ plus the magnitude -> dB stage on its own against juce::Decibels::gainToDecibels,
+ and the multi-resolution cascade over one second of audio against single FFTs at the same
+ frame rate with its top and its lowest stage's resolution (8192 and 65536 points).
+ */
+juce::var runFFTBenchmark(int iterations);
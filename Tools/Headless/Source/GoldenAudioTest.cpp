@@ -0,0 +1,487 @@
+/*
+  ==============================================================================
+
+    GoldenAudioTest.cpp
+    Created: 20 Oct 2026 12:18:40am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "GoldenAudioTest.h"
+#include "ProcessorHarness.h"
+#include <set>
+#include <functional>
+
+namespace
+{
+constexpr double sampleRate = 48000.0;
+constexpr int blockSize = 512;
+constexpr int numChannels = 2;
+constexpr int numSamples = (int)sampleRate;    //one second
+
+//==============================================================================
+using Generator = std::function<float(int sample, int channel)>;
+
+juce::AudioBuffer<float> generate(Generator&& func)
+{
+    juce::AudioBuffer<float> buffer(numChannels, numSamples);
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        for (int i = 0; i < numSamples; ++i)
+            buffer.setSample(ch, i, func(i, ch));
+    }
+
+    return buffer;
+}
+
+juce::AudioBuffer<float> makeSine(double frequency)
+{
+    return generate([frequency](int i, int)
+        {
+            return 0.5f * (float)std::sin(juce::MathConstants<double>::twoPi * frequency * i / sampleRate);
+        });
+}
+
+//20Hz to 20kHz, exponentially.
+juce::AudioBuffer<float> makeLogSweep()
+{
+    const auto f0 = 20.0, f1 = 20000.0;
+    const auto duration = numSamples / sampleRate;
+    const auto k = std::log(f1 / f0);
+
+    return generate([=](int i, int)
+        {
+            auto t = i / sampleRate;
+            auto phase = juce::MathConstants<double>::twoPi * f0 * duration / k * (std::exp(t / duration * k) - 1.0);
+            return 0.5f * (float)std::sin(phase);
+        });
+}
+
+//white noise through Paul Kellet's pink filter, different on each channel.
+juce::AudioBuffer<float> makePinkNoise()
+{
+    juce::AudioBuffer<float> buffer(numChannels, numSamples);
+    juce::Random random(1357);
+
+    for (int ch = 0; ch < numChannels; ++ch)
+    {
+        float b0 = 0, b1 = 0, b2 = 0, b3 = 0, b4 = 0, b5 = 0, b6 = 0;
+        for (int i = 0; i < numSamples; ++i)
+        {
+            auto white = random.nextFloat() * 2.f - 1.f;
+            b0 = 0.99886f * b0 + white * 0.0555179f;
+            b1 = 0.99332f * b1 + white * 0.0750759f;
+            b2 = 0.96900f * b2 + white * 0.1538520f;
+            b3 = 0.86650f * b3 + white * 0.3104856f;
+            b4 = 0.55000f * b4 + white * 0.5329522f;
+            b5 = -0.7616f * b5 - white * 0.0168980f;
+            buffer.setSample(ch, i, 0.1f * (b0 + b1 + b2 + b3 + b4 + b5 + b6 + white * 0.5362f));
+            b6 = white * 0.115926f;
+        }
+    }
+
+    return buffer;
+}
+
+//full scale clicks every 100ms, so the filters ring out between them.
+juce::AudioBuffer<float> makeImpulses()
+{
+    const auto spacing = (int)(sampleRate * 0.1);
+    return generate([spacing](int i, int) { return i % spacing == 0 ? 1.f : 0.f; });
+}
+
+//two beats at 120bpm: kick on the beats, snare on the off-beats, closed hats on the eighths.
+juce::AudioBuffer<float> makeDrumLoop()
+{
+    juce::AudioBuffer<float> buffer(numChannels, numSamples);
+    buffer.clear();
+    juce::Random random(2468);
+
+    const auto eighth = (int)(sampleRate * 0.125);
+
+    auto addHit = [&buffer](int start, int length, auto&& sampleAt)
+    {
+        for (int i = 0; i < length && start + i < numSamples; ++i)
+        {
+            auto value = sampleAt(i / sampleRate);
+            for (int ch = 0; ch < numChannels; ++ch)
+                buffer.addSample(ch, start + i, value);
+        }
+    };
+
+    for (int step = 0; step < numSamples / eighth; ++step)
+    {
+        auto start = step * eighth;
+
+        if (step % 4 == 0)
+        {
+            //a sine falling from 150Hz to 50Hz.
+            double phase = 0.0;
+            addHit(start, (int)(sampleRate * 0.3), [&phase](double t)
+                {
+                    phase += juce::MathConstants<double>::twoPi * (50.0 + 100.0 * std::exp(-t * 30.0)) / sampleRate;
+                    return 0.9f * (float)(std::exp(-t * 12.0) * std::sin(phase));
+                });
+        }
+
+        if (step % 4 == 2)
+        {
+            addHit(start, (int)(sampleRate * 0.2), [&random](double t)
+                {
+                    auto tone = std::sin(juce::MathConstants<double>::twoPi * 190.0 * t);
+                    auto noise = random.nextFloat() * 2.f - 1.f;
+                    return (float)(std::exp(-t * 25.0) * (0.3 * tone + 0.5 * noise));
+                });
+        }
+
+        float previous = 0.f;
+        addHit(start, (int)(sampleRate * 0.05), [&random, &previous](double t)
+            {
+                //first difference: crude, but it takes the lows out of the noise.
+                auto noise = random.nextFloat() * 2.f - 1.f;
+                auto highpassed = noise - previous;
+                previous = noise;
+                return 0.15f * (float)std::exp(-t * 80.0) * highpassed;
+            });
+    }
+
+    return buffer;
+}
+
+struct Signal
+{
+    const char* name;
+    juce::AudioBuffer<float> buffer;
+};
+
+std::vector<Signal> makeSignals()
+{
+    std::vector<Signal> signals;
+    signals.push_back({ "sine100", makeSine(100.0) });
+    signals.push_back({ "sine1k", makeSine(1000.0) });
+    signals.push_back({ "sine10k", makeSine(10000.0) });
+    signals.push_back({ "logSweep", makeLogSweep() });
+    signals.push_back({ "pinkNoise", makePinkNoise() });
+    signals.push_back({ "impulses", makeImpulses() });
+    signals.push_back({ "drumLoop", makeDrumLoop() });
+    return signals;
+}
+
+//==============================================================================
+struct Setting
+{
+    const char* name;
+    std::vector<std::pair<Params::Names, float>> values;   //in each parameter's own units
+};
+
+const std::vector<Setting>& getSettings()
+{
+    using namespace Params;
+    static const std::vector<Setting> settings
+    {
+        { "defaults", {} },
+        { "heavy", { { Threshold_Low_Band, -40.f }, { Threshold_Mid_Band, -40.f }, { Threshold_High_Band, -40.f },
+                     { Attack_Low_band, 5.f }, { Attack_Mid_band, 5.f }, { Attack_High_band, 5.f },
+                     { Release_Low_Band, 5.f }, { Release_Mid_Band, 5.f }, { Release_High_Band, 5.f },
+                     { Ratio_Low_Band, (float)(RatioChoices.size() - 1) }, { Ratio_Mid_Band, (float)(RatioChoices.size() - 1) },
+                     { Ratio_High_Band, (float)(RatioChoices.size() - 1) } } },
+        { "slow", { { Threshold_Low_Band, -20.f }, { Threshold_Mid_Band, -25.f }, { Threshold_High_Band, -30.f },
+                    { Attack_Low_band, 500.f }, { Attack_Mid_band, 250.f }, { Attack_High_band, 100.f },
+                    { Release_Low_Band, 500.f }, { Release_Mid_Band, 300.f }, { Release_High_Band, 200.f } } },
+        { "crossoverExtremes", { { Low_Mid_Crossover_Freq, MIN_FREQUENCY }, { Mid_High_Crossover_Freq, MAX_FREQUENCY },
+                                 { Threshold_Mid_Band, -30.f } } },
+        { "gains", { { Gain_In, 12.f }, { Gain_Out, -6.f }, { Threshold_Low_Band, -24.f }, { Threshold_High_Band, -12.f } } },
+        { "muteAndBypass", { { Mute_Mid_Band, 1.f }, { Bypass_High_Band, 1.f }, { Threshold_Low_Band, -30.f } } },
+        { "allBypassed", { { Bypass_Low_Band, 1.f }, { Bypass_Mid_Band, 1.f }, { Bypass_High_Band, 1.f },
+                           { Low_Mid_Crossover_Freq, 500.f }, { Mid_High_Crossover_Freq, 5000.f } } },
+    };
+
+    return settings;
+}
+
+bool bypassesCompressors(const Setting& setting)
+{
+    return juce::String(setting.name) == "allBypassed";
+}
+
+//the full output, then each band on its own.
+const std::array<const char*, 4> stageNames{ "output", "low", "mid", "high" };
+
+juce::AudioBuffer<float> render(const juce::AudioBuffer<float>& signal, const Setting& setting, int soloBand)
+{
+    SimpleMBCompAudioProcessor processor;
+    for (const auto& [name, value] : setting.values)
+        setParameter(processor, name, value);
+
+    const Params::Names solo[] = { Params::Solo_Low_Band, Params::Solo_Mid_Band, Params::Solo_High_Band };
+    for (int band = 0; band < 3; ++band)
+        setParameter(processor, solo[band], band == soloBand ? 1.f : 0.f);
+
+    juce::AudioBuffer<float> output(signal);
+    juce::MidiBuffer midi;
+
+    if (!prepareProcessor(processor, sampleRate, blockSize, numChannels))
+        return {};
+
+    for (int start = 0; start < output.getNumSamples(); start += blockSize)
+    {
+        auto length = juce::jmin(blockSize, output.getNumSamples() - start);
+        juce::AudioBuffer<float> block(output.getArrayOfWritePointers(), numChannels, start, length);
+        processor.processBlock(block, midi);
+    }
+
+    processor.releaseResources();
+    return output;
+}
+
+//==============================================================================
+constexpr int referenceVersion = 1;
+constexpr double envelopeWindowSeconds = 0.05;
+constexpr float silencedB = -200.f;
+
+//what's kept of a render: enough to tell identical, close and different apart, in a few hundred bytes.
+struct Fingerprint
+{
+    juce::String hash;
+    float peak = 0.f;
+    std::vector<float> envelopedB;    //RMS of both channels per window
+};
+
+//FNV-1a over the raw sample bits: only a bit identical render hashes the same.
+juce::String hashSamples(const juce::AudioBuffer<float>& buffer)
+{
+    juce::uint64 hash = 14695981039346656037ull;
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        auto* bytes = reinterpret_cast<const juce::uint8*>(buffer.getReadPointer(ch));
+        for (size_t i = 0; i < (size_t)buffer.getNumSamples() * sizeof(float); ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    }
+
+    return juce::String::toHexString((juce::int64)hash).paddedLeft('0', 16);
+}
+
+Fingerprint makeFingerprint(const juce::AudioBuffer<float>& buffer)
+{
+    Fingerprint fingerprint;
+    fingerprint.hash = hashSamples(buffer);
+
+    const auto windowLength = (int)(envelopeWindowSeconds * sampleRate);
+    for (int start = 0; start < buffer.getNumSamples(); start += windowLength)
+    {
+        auto length = juce::jmin(windowLength, buffer.getNumSamples() - start);
+        double squares = 0.0;
+
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            auto* samples = buffer.getReadPointer(ch, start);
+            for (int i = 0; i < length; ++i)
+            {
+                fingerprint.peak = juce::jmax(fingerprint.peak, std::abs(samples[i]));
+                squares += (double)samples[i] * samples[i];
+            }
+        }
+
+        auto meanSquare = squares / juce::jmax(1, length * buffer.getNumChannels());
+        fingerprint.envelopedB.push_back(meanSquare > 0.0 ? juce::jmax(silencedB, (float)(10.0 * std::log10(meanSquare))) : silencedB);
+    }
+
+    return fingerprint;
+}
+
+juce::var toVar(const Fingerprint& fingerprint)
+{
+    //thousandths of a dB as integers keep the file small.
+    juce::Array<juce::var> envelope;
+    for (auto value : fingerprint.envelopedB)
+        envelope.add(juce::roundToInt(value * 1000.f));
+
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("hash", fingerprint.hash);
+    obj->setProperty("peak", fingerprint.peak);
+    obj->setProperty("envelopeMillidB", envelope);
+    return juce::var(obj);
+}
+
+bool fromVar(const juce::var& value, Fingerprint& fingerprint)
+{
+    auto* envelope = value["envelopeMillidB"].getArray();
+    if (!value.hasProperty("hash") || envelope == nullptr)
+        return false;
+
+    fingerprint.hash = value["hash"].toString();
+    fingerprint.peak = (float)value["peak"];
+    fingerprint.envelopedB.clear();
+    for (const auto& v : *envelope)
+        fingerprint.envelopedB.push_back((float)(int)v / 1000.f);
+
+    return true;
+}
+
+struct Comparison
+{
+    bool identical = false;
+    float peakError = 0.f;
+    float maxEnvelopeErrordB = 0.f;
+};
+
+Comparison compare(const Fingerprint& rendered, const Fingerprint& reference)
+{
+    Comparison comparison;
+    comparison.identical = rendered.hash == reference.hash;
+    comparison.peakError = std::abs(rendered.peak - reference.peak);
+
+    for (size_t i = 0; i < rendered.envelopedB.size(); ++i)
+    {
+        //below this nothing can be heard, and a few ulps make tens of dB.
+        constexpr float floordB = -120.f;
+        auto a = juce::jmax(floordB, rendered.envelopedB[i]);
+        auto b = juce::jmax(floordB, reference.envelopedB[i]);
+        comparison.maxEnvelopeErrordB = juce::jmax(comparison.maxEnvelopeErrordB, std::abs(a - b));
+    }
+
+    return comparison;
+}
+
+bool writeReferences(const juce::File& file, const juce::var& renders)
+{
+    auto* root = new juce::DynamicObject();
+    juce::var rootVar(root);
+    root->setProperty("version", referenceVersion);
+    root->setProperty("sampleRate", sampleRate);
+    root->setProperty("blockSize", blockSize);
+    root->setProperty("envelopeWindowSeconds", envelopeWindowSeconds);
+    root->setProperty("renders", renders);
+
+    return file.getParentDirectory().createDirectory() && file.replaceWithText(juce::JSON::toString(rootVar));
+}
+}
+
+juce::var runGoldenAudioTest(const GoldenAudioOptions& options)
+{
+    auto* results = new juce::DynamicObject();
+    juce::var resultsVar(results);
+
+    juce::var references;
+    if (!options.record)
+    {
+        references = juce::JSON::parse(options.referenceFile);
+        if ((int)references["version"] != referenceVersion)
+        {
+            results->setProperty("error", "no references in " + options.referenceFile.getFullPathName() + ": record them with --golden --record");
+            results->setProperty("passed", false);
+            return resultsVar;
+        }
+    }
+
+    auto* recorded = new juce::DynamicObject();
+    juce::var recordedVar(recorded);
+
+    juce::Array<juce::var> cases;
+    std::set<juce::String> divergedBands;
+    bool crossoverDiverged = false, compressingSettingDiverged = false;
+    int numRenders = 0, numFailed = 0;
+
+    for (const auto& signal : makeSignals())
+    {
+        for (const auto& setting : getSettings())
+        {
+            auto* testCase = new juce::DynamicObject();
+            testCase->setProperty("signal", juce::String(signal.name));
+            testCase->setProperty("setting", juce::String(setting.name));
+
+            auto* stages = new juce::DynamicObject();
+            bool casePassed = true;
+
+            for (int stage = 0; stage < (int)stageNames.size(); ++stage)
+            {
+                const auto stageName = juce::String(stageNames[(size_t)stage]);
+                const auto key = juce::String(signal.name) + "_" + setting.name + "_" + stageName;
+                auto rendered = makeFingerprint(render(signal.buffer, setting, stage - 1));
+                ++numRenders;
+
+                auto* stageResult = new juce::DynamicObject();
+
+                if (options.record)
+                {
+                    recorded->setProperty(key, toVar(rendered));
+                }
+                else
+                {
+                    Fingerprint reference;
+                    if (!fromVar(references["renders"][juce::Identifier(key)], reference))
+                    {
+                        stageResult->setProperty("error", "no reference for " + key);
+                        casePassed = false;
+                    }
+                    else if (reference.envelopedB.size() != rendered.envelopedB.size())
+                    {
+                        stageResult->setProperty("error", "reference is a different length");
+                        casePassed = false;
+                    }
+                    else
+                    {
+                        auto comparison = compare(rendered, reference);
+                        auto passed = comparison.identical
+                                   || (comparison.peakError <= options.maxAbsError && comparison.maxEnvelopeErrordB <= options.maxEnvelopeErrordB);
+
+                        stageResult->setProperty("identical", comparison.identical);
+                        stageResult->setProperty("peakError", comparison.peakError);
+                        stageResult->setProperty("maxEnvelopeErrordB", comparison.maxEnvelopeErrordB);
+                        stageResult->setProperty("passed", passed);
+
+                        if (!passed)
+                        {
+                            casePassed = false;
+                            if (stage > 0)
+                                divergedBands.insert(stageName);
+
+                            (bypassesCompressors(setting) ? crossoverDiverged : compressingSettingDiverged) = true;
+                        }
+                    }
+                }
+
+                stages->setProperty(stageName, juce::var(stageResult));
+            }
+
+            testCase->setProperty("stages", juce::var(stages));
+            testCase->setProperty("passed", casePassed);
+            cases.add(juce::var(testCase));
+
+            if (!casePassed)
+                ++numFailed;
+        }
+    }
+
+    juce::Array<juce::var> bands, divergedStages;
+    for (const auto& band : divergedBands)
+        bands.add(band);
+
+    //with the crossover on its own still nulling, anything else that doesn't is down to the compressors.
+    if (crossoverDiverged)
+        divergedStages.add("crossover");
+    if (compressingSettingDiverged)
+        divergedStages.add(crossoverDiverged ? "compressor (can't be told apart: the crossover diverged too)" : "compressor");
+
+    if (options.record && !writeReferences(options.referenceFile, recordedVar))
+    {
+        results->setProperty("error", "can't write " + options.referenceFile.getFullPathName());
+        numFailed = numRenders;
+    }
+
+    results->setProperty("mode", options.record ? "record" : "compare");
+    results->setProperty("referenceFile", options.referenceFile.getFullPathName());
+    results->setProperty("maxAbsError", options.maxAbsError);
+    results->setProperty("maxEnvelopeErrordB", options.maxEnvelopeErrordB);
+    results->setProperty("renders", numRenders);
+    results->setProperty("cases", cases);
+    results->setProperty("failedCases", numFailed);
+    results->setProperty("divergedBands", bands);
+    results->setProperty("divergedStages", divergedStages);
+    results->setProperty("passed", numFailed == 0);
+    return resultsVar;
+}
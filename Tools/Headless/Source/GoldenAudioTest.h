@@ -0,0 +1,43 @@
+/*
+  ==============================================================================
+
+    GoldenAudioTest.h
+    Created: 20 Oct 2026 12:18:40am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+struct GoldenAudioOptions
+{
+    //the checked in reference set: a JSON fingerprint of every render (see below).
+    juce::File referenceFile;
+
+    //write the references instead of comparing against them.
+    bool record = false;
+
+    //a render that isn't bit identical passes if its peak and every window of its envelope are within these.
+    float maxAbsError = 1.0e-5f;
+    float maxEnvelopeErrordB = 0.01f;
+};
+
+/*
+ renders sines, a log sweep, pink noise, an impulse train and a synthetic drum loop through
+ the processor at a range of settings, and compares every render with its stored reference.
+
+ besides the full output, each case is also rendered with each band soloed, so a divergence can
+ be put down to a band. the allBypassed setting only goes through the crossover, so it diverging
+ points at the crossover rather than the compressors.
+ returns every case's differences per stage, which bands and stages diverged, and 'passed'.
+
+ the references are small enough to live in the repo (Tools/Headless/golden/references.json):
+ per render a hash of the samples, the peak, and the RMS envelope in 50ms windows. a render
+ with the same hash is identical; otherwise the peak and the envelope have to be within the
+ tolerances, so toolchain noise passes and a real change to the DSP doesn't.
+ re-record them with --golden --record (or golden.sh --record) when the DSP is meant to change,
+ and commit the file with the change.
+ */
+juce::var runGoldenAudioTest(const GoldenAudioOptions& options);
@@ -0,0 +1,50 @@
+/*
+  ==============================================================================
+
+    InstantiationBenchmark.cpp
+    Created: 19 Oct 2026 9:12:36pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "InstantiationBenchmark.h"
+#include "BenchmarkUtilities.h"
+#include "../../../Source/PluginProcessor.h"
+
+juce::var runInstantiationBenchmark(int iterations)
+{
+    const auto warmup = juce::jmax(1, iterations / 10);
+
+    auto* results = new juce::DynamicObject();
+
+    results->setProperty("processor", toVar(runBenchmark(iterations, warmup, []()
+        {
+            SimpleMBCompAudioProcessor processor;
+        })));
+
+    results->setProperty("processorPrepared", toVar(runBenchmark(iterations, warmup, []()
+        {
+            SimpleMBCompAudioProcessor processor;
+            processor.prepareToPlay(48000.0, 512);
+            processor.releaseResources();
+        })));
+
+    SimpleMBCompAudioProcessor processor;
+
+    results->setProperty("editor", toVar(runBenchmark(iterations, warmup, [&processor]()
+        {
+            std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditor());
+        })));
+
+    results->setProperty("editorFirstPaint", toVar(runBenchmark(iterations, warmup, [&processor]()
+        {
+            std::unique_ptr<juce::AudioProcessorEditor> editor(processor.createEditor());
+
+            juce::Image frame(juce::Image::ARGB, editor->getWidth(), editor->getHeight(), true);
+            juce::Graphics g(frame);
+            editor->paintEntireComponent(g, false);
+        })));
+
+    return juce::var(results);
+}
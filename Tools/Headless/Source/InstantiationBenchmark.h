@@ -0,0 +1,20 @@
+/*
+  ==============================================================================
+
+    InstantiationBenchmark.h
+    Created: 19 Oct 2026 9:12:36pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ what a host pays to scan and open the plugin:
+ 'processor' constructs and destroys a processor, 'processorPrepared' adds prepareToPlay(),
+ 'editor' opens and closes an editor on one processor, 'editorFirstPaint' also paints it once.
+ the editor is never put on screen, so the analyzer's FFTs are never allocated here.
+ */
+juce::var runInstantiationBenchmark(int iterations);
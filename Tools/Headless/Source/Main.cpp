@@ -0,0 +1,258 @@
+/*
+  ==============================================================================
+
+    Main.cpp
+    Created: 19 Oct 2026 9:38:44am
+    Author:  brand
+
+    Headless harness for SimpleMBComp: runs benchmarks without a host or editor
+    and prints the results as JSON, so runs can be diffed against each other.
+
+  ==============================================================================
+*/
+
+#include <JuceHeader.h>
+#include <iostream>
+#include "AnalyzerHopTest.h"
+#include "BatchRender.h"
+#include "FFTBenchmark.h"
+#include "GoldenAudioTest.h"
+#include "InstantiationBenchmark.h"
+#include "PaintBenchmark.h"
+#include "ProcessBenchmark.h"
+#include "ProfileTrace.h"
+#include "RealtimeSafetyTest.h"
+#include "StateBenchmark.h"
+#include "TraceBenchmark.h"
+#include "TransferFunctionTest.h"
+
+namespace
+{
+int getIterations(const juce::ArgumentList& args, int defaultIterations)
+{
+    auto value = args.getValueForOption("--iterations");
+    return value.isNotEmpty() ? juce::jmax(1, value.getIntValue()) : defaultIterations;
+}
+
+void printResult(const juce::String& benchmarkName, const juce::var& result)
+{
+    auto* obj = new juce::DynamicObject();
+    obj->setProperty("benchmark", benchmarkName);
+    obj->setProperty("results", result);
+    std::cout << juce::JSON::toString(juce::var(obj)) << std::endl;
+}
+}
+
+int main(int argc, char* argv[])
+{
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::ConsoleApplication app;
+    app.addHelpCommand("--help|-h", "Usage:", true);
+
+    app.addCommand({ "--fft",
+                     "--fft [--iterations=N]",
+                     "Benchmarks FFT data generation for every FFT order.",
+                     "Times produceFFTDataForRendering and the magnitude to dB conversion for order2048 to order16384.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         printResult("fft", runFFTBenchmark(getIterations(args, 2000)));
+                     } });
+
+    app.addCommand({ "--hops",
+                     "--hops",
+                     "Checks the analyzer runs one FFT per hop.",
+                     "Feeds 2 seconds of audio through PathProducer at several FFT sizes and the multi-resolution cascade, "
+                     "at several overlaps and block sizes, "
+                     "including blocks longer than the hop, and checks N samples give floor(N / hop) frames. Exits with 1 if not.",
+                     [](const juce::ArgumentList&)
+                     {
+                         auto result = runAnalyzerHopTest();
+                         printResult("hops", result);
+
+                         if (!(bool)result["passed"])
+                             juce::ConsoleApplication::fail("the analyzer skipped or added hops", 1);
+                     } });
+
+    app.addCommand({ "--paint",
+                     "--paint [--iterations=N]",
+                     "Benchmarks SpectrumAnalyzer::paint.",
+                     "Paints the analyzer offscreen at 550x230 and 2000x800, with and without the cached background.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         printResult("paint", runPaintBenchmark(getIterations(args, 500)));
+                     } });
+
+    app.addCommand({ "--traces",
+                     "--traces [--iterations=N]",
+                     "Benchmarks spectrum trace rendering.",
+                     "Compares strokePath with SpectrumTraceRenderer for two 8192 point spectra at 550px and 2000px.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         printResult("traces", runTraceBenchmark(getIterations(args, 1000)));
+                     } });
+
+    app.addCommand({ "--instantiate",
+                     "--instantiate [--iterations=N]",
+                     "Benchmarks processor instantiation and opening the editor.",
+                     "Times constructing a processor (with and without prepareToPlay), opening an editor, and opening plus painting it once.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         printResult("instantiate", runInstantiationBenchmark(getIterations(args, 50)));
+                     } });
+
+    app.addCommand({ "--state",
+                     "--state [--iterations=N]",
+                     "Benchmarks saving and restoring the plugin state.",
+                     "Times getStateInformation and setStateInformation with the binary format and the old ValueTree "
+                     "format, restoring an unchanged state, a state with one parameter changed, and an old ValueTree blob.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         printResult("state", runStateBenchmark(getIterations(args, 10000)));
+                     } });
+
+    app.addCommand({ "--process",
+                     "--process [--seconds=S]",
+                     "Benchmarks processBlock without an editor.",
+                     "Runs S seconds (default 1) of noise through every combination of sample rate, block size, "
+                     "channel count, solo/mute/bypass state and automation on/off.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         auto seconds = args.getValueForOption("--seconds");
+                         printResult("process", runProcessBenchmark(seconds.isNotEmpty() ? juce::jmax(0.01, seconds.getDoubleValue()) : 1.0));
+                     } });
+
+    app.addCommand({ "--profile",
+                     "--profile [--output=file] [--seconds=S]",
+                     "Records per-stage processBlock timers to a Chrome trace.",
+                     "Runs S seconds (default 2) of 48kHz/512 stereo with automation and every analyzer tap subscribed, "
+                     "writing trace_event JSON to the output file (default processBlock.trace.json) for chrome://tracing. "
+                     "Needs the Profile build configuration, which is the only one with the timers compiled in. "
+                     "Exits with 1 in any other configuration, or if the trace couldn't be written.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         auto output = args.getValueForOption("--output");
+                         auto file = juce::File::getCurrentWorkingDirectory().getChildFile(output.isNotEmpty() ? output : "processBlock.trace.json");
+                         auto seconds = args.getValueForOption("--seconds");
+                         auto result = runProfileTrace(file, seconds.isNotEmpty() ? juce::jmax(0.01, seconds.getDoubleValue()) : 2.0);
+                         printResult("profile", result);
+
+                         //a build without the timers writes no trace, which a script must not mistake for success.
+                         if (result.hasProperty("error"))
+                             juce::ConsoleApplication::fail(result["error"].toString(), 1);
+                     } });
+
+    app.addCommand({ "--rtcheck",
+                     "--rtcheck [--abort]",
+                     "Checks processBlock for allocations, locks and system calls.",
+                     "Runs processBlock through steady state, short blocks, automation, band state changes, analyzer "
+                     "subscriptions and sample rate changes. Violations are logged to stderr with a stack trace, or abort "
+                     "the run with --abort. Exits with 1 if any were found.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         auto action = args.containsOption("--abort") ? RealtimeSafety::ViolationAction::Abort
+                                                                      : RealtimeSafety::ViolationAction::Log;
+                         auto result = runRealtimeSafetyTest(action);
+                         printResult("rtcheck", result);
+
+                         if (!(bool)result["passed"])
+                             juce::ConsoleApplication::fail("real-time safety violations found", 1);
+                     } });
+
+    app.addCommand({ "--render",
+                     "--render [--state=file] [--output-dir=dir] [--format=wav|flac|aiff] [--jobs=N] [--block=N] files or directories...",
+                     "Renders audio files through the processor offline.",
+                     "Loads a state blob (getStateInformation output) or an XML preset and renders every WAV, FLAC and AIFF "
+                     "file given (directories are searched recursively) into the output directory (default ./rendered), "
+                     "N files at a time (default one per CPU) in blocks of N samples (default 8192). The output is the "
+                     "same for any number of jobs. Exits with 1 if any file failed.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         BatchRenderOptions options;
+
+                         auto state = args.getValueForOption("--state");
+                         if (state.isNotEmpty())
+                             options.stateFile = juce::File::getCurrentWorkingDirectory().getChildFile(state);
+
+                         auto outputDirectory = args.getValueForOption("--output-dir");
+                         options.outputDirectory = juce::File::getCurrentWorkingDirectory().getChildFile(outputDirectory.isNotEmpty() ? outputDirectory : "rendered");
+                         options.outputFormat = args.getValueForOption("--format").toLowerCase();
+
+                         auto jobs = args.getValueForOption("--jobs");
+                         if (jobs.isNotEmpty())
+                             options.numWorkers = juce::jmax(1, jobs.getIntValue());
+
+                         auto blockSize = args.getValueForOption("--block");
+                         if (blockSize.isNotEmpty())
+                             options.blockSize = juce::jmax(1, blockSize.getIntValue());
+
+                         for (auto& arg : args.arguments)
+                         {
+                             if (!arg.isOption())
+                                 options.inputs.add(arg.resolveAsFile());
+                         }
+
+                         if (options.inputs.isEmpty())
+                             juce::ConsoleApplication::fail("no input files given", 1);
+
+                         auto result = runBatchRender(options);
+                         printResult("render", result);
+
+                         if (result.hasProperty("error") || (int)result["failed"] > 0)
+                             juce::ConsoleApplication::fail("some files were not rendered", 1);
+                     } });
+
+    app.addCommand({ "--golden",
+                     "--golden [--record] [--references=file] [--max-abs=X] [--max-envelope-db=dB]",
+                     "Compares renders against the checked in reference set.",
+                     "Renders sines, a log sweep, pink noise, impulses and a drum loop at a range of settings, as the full "
+                     "output and with each band soloed, and compares each with its fingerprint in the reference file "
+                     "(default Tools/Headless/golden/references.json, from the repository root). A render passes if it is "
+                     "bit identical, or if its peak is within X (default 1e-5) and its 50ms RMS envelope within dB "
+                     "(default 0.01). --record rewrites the file, for a change that is meant to alter the audio. "
+                     "Exits with 1 if any failed.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         GoldenAudioOptions options;
+                         options.record = args.containsOption("--record");
+
+                         auto references = args.getValueForOption("--references");
+                         options.referenceFile = juce::File::getCurrentWorkingDirectory().getChildFile(references.isNotEmpty() ? references : "Tools/Headless/golden/references.json");
+
+                         auto maxAbs = args.getValueForOption("--max-abs");
+                         if (maxAbs.isNotEmpty())
+                             options.maxAbsError = maxAbs.getFloatValue();
+
+                         auto maxEnvelope = args.getValueForOption("--max-envelope-db");
+                         if (maxEnvelope.isNotEmpty())
+                             options.maxEnvelopeErrordB = maxEnvelope.getFloatValue();
+
+                         auto result = runGoldenAudioTest(options);
+                         printResult("golden", result);
+
+                         if (!(bool)result["passed"])
+                             juce::ConsoleApplication::fail("renders differ from the references", 1);
+                     } });
+
+    app.addCommand({ "--transfer",
+                     "--transfer [--sample-rate=SR] [--tolerance=dB] [--curves]",
+                     "Measures the processor's transfer function and checks the bands sum flat.",
+                     "Sweeps the processor at several crossover settings, with the bands bypassed and with the compressors "
+                     "below threshold, and deconvolves magnitude, phase and group delay. Fails if the magnitude leaves "
+                     "0dB +-dB (default 0.1) anywhere from 20Hz to 20kHz. --curves includes the full curves. Exits with 1 on failure.",
+                     [](const juce::ArgumentList& args)
+                     {
+                         auto sampleRate = args.getValueForOption("--sample-rate");
+                         auto tolerance = args.getValueForOption("--tolerance");
+
+                         auto result = runTransferFunctionTest(sampleRate.isNotEmpty() ? juce::jmax(8000.0, sampleRate.getDoubleValue()) : 48000.0,
+                                                               tolerance.isNotEmpty() ? tolerance.getFloatValue() : 0.1f,
+                                                               args.containsOption("--curves"));
+                         printResult("transfer", result);
+
+                         if (!(bool)result["passed"])
+                             juce::ConsoleApplication::fail("the bands don't sum flat", 1);
+                     } });
+
+    return app.findAndRunCommand(argc, argv);
+}
@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    PaintBenchmark.cpp
+    Created: 19 Oct 2026 3:12:27pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "PaintBenchmark.h"
+#include "BenchmarkUtilities.h"
+#include "../../../Source/PluginProcessor.h"
+#include "../../../Source/GUI/SpectrumAnalyzer.h"
+
+juce::var runPaintBenchmark(int iterations)
+{
+    const auto warmup = juce::jmax(1, iterations / 10);
+
+    SimpleMBCompAudioProcessor processor;
+    SpectrumAnalyzer analyzer(processor);
+
+    auto* results = new juce::DynamicObject();
+
+    for (auto size : { juce::Point<int>(550, 230), juce::Point<int>(2000, 800) })
+    {
+        analyzer.setBounds(0, 0, size.x, size.y);
+
+        //one pixel wider than the biggest bounds used below.
+        juce::Image frame(juce::Image::ARGB, size.x + 1, size.y, true);
+
+        auto paintFrame = [&]()
+        {
+            juce::Graphics g(frame);
+            analyzer.paintEntireComponent(g, false);
+        };
+
+        auto cached = runBenchmark(iterations, warmup, paintFrame);
+
+        int extraWidth = 0;
+        auto rebuilt = runBenchmark(iterations, warmup, [&]()
+        {
+            extraWidth ^= 1;
+            analyzer.setBounds(0, 0, size.x + extraWidth, size.y);
+            paintFrame();
+        });
+
+        auto* sizeResult = new juce::DynamicObject();
+        sizeResult->setProperty("frame", toVar(cached));
+        sizeResult->setProperty("frameWithBackgroundRebuild", toVar(rebuilt));
+        results->setProperty(juce::String(size.x) + "x" + juce::String(size.y), juce::var(sizeResult));
+    }
+
+    return juce::var(results);
+}
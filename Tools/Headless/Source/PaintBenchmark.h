@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    PaintBenchmark.h
+    Created: 19 Oct 2026 3:12:27pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ paints a SpectrumAnalyzer into an offscreen image at the editor's size and a large one.
+ 'frame' is the steady state where the cached background is reused, 'frameWithBackgroundRebuild'
+ resizes before every paint so the grid, labels and frame are drawn from scratch each time.
+ */
+juce::var runPaintBenchmark(int iterations);
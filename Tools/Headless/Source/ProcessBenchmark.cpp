@@ -0,0 +1,124 @@
+/*
+  ==============================================================================
+
+    ProcessBenchmark.cpp
+    Created: 19 Oct 2026 9:48:05pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "ProcessBenchmark.h"
+#include "BenchmarkUtilities.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+struct ProcessConfig
+{
+    double sampleRate;
+    int blockSize;
+    int numChannels;
+    const BandStates* bandStates;
+    bool automation;
+};
+
+juce::var runConfig(const ProcessConfig& config, const juce::AudioBuffer<float>& source, double secondsPerConfig)
+{
+    SimpleMBCompAudioProcessor processor;
+    if (!prepareProcessor(processor, config.sampleRate, config.blockSize, config.numChannels))
+        return {};
+
+    applyBandStates(processor, *config.bandStates);
+
+    const auto numBlocks = juce::jmax(1, (int)(secondsPerConfig * config.sampleRate / config.blockSize));
+    const auto warmup = juce::jmax(1, numBlocks / 10);
+
+    juce::AudioBuffer<float> buffer(config.numChannels, config.blockSize);
+    juce::MidiBuffer midi;
+    int readPosition = 0;
+
+    //one automation cycle over the run, whatever its length.
+    auto processNextBlock = [&](int blockIndex)
+    {
+        if (readPosition + config.blockSize > source.getNumSamples())
+            readPosition = 0;
+
+        for (int ch = 0; ch < config.numChannels; ++ch)
+            buffer.copyFrom(ch, 0, source, ch, readPosition, config.blockSize);
+
+        readPosition += config.blockSize;
+
+        if (config.automation)
+            applyAutomation(processor, (double)blockIndex / (double)numBlocks);
+
+        auto start = juce::Time::getHighResolutionTicks();
+        processor.processBlock(buffer, midi);
+        return ticksToNanoseconds(juce::Time::getHighResolutionTicks() - start);
+    };
+
+    for (int i = 0; i < warmup; ++i)
+        processNextBlock(i);
+
+    std::vector<double> timingsNs;
+    timingsNs.reserve((size_t)numBlocks);
+
+    for (int i = 0; i < numBlocks; ++i)
+        timingsNs.push_back(processNextBlock(i));
+
+    processor.releaseResources();
+
+    auto stats = computeStats(timingsNs);
+    const auto blockDurationNs = 1.0e9 * config.blockSize / config.sampleRate;
+
+    auto* result = new juce::DynamicObject();
+    result->setProperty("sampleRate", config.sampleRate);
+    result->setProperty("blockSize", config.blockSize);
+    result->setProperty("channels", config.numChannels);
+    result->setProperty("bands", juce::String(config.bandStates->name));
+    result->setProperty("automation", config.automation);
+    result->setProperty("blocks", stats.iterations);
+    result->setProperty("nsPerSample", stats.meanNs / config.blockSize);
+    result->setProperty("p50Ns", stats.p50Ns);
+    result->setProperty("p99Ns", stats.p99Ns);
+    result->setProperty("maxNs", stats.maxNs);
+    result->setProperty("realTimeFactor", stats.meanNs > 0.0 ? blockDurationNs / stats.meanNs : 0.0);
+    return juce::var(result);
+}
+}
+
+juce::var runProcessBenchmark(double secondsPerConfig)
+{
+    //long enough that consecutive blocks don't repeat at any block size.
+    juce::AudioBuffer<float> source(2, 1 << 16);
+    fillWithNoise(source, 0.5f, 1234);
+
+    juce::Array<juce::var> configs;
+
+    for (auto sampleRate : { 44100.0, 48000.0, 96000.0, 192000.0 })
+    {
+        for (int blockSize = 16; blockSize <= 4096; blockSize *= 2)
+        {
+            for (auto numChannels : { 1, 2 })
+            {
+                for (const auto& bandStates : getBandStateScenarios())
+                {
+                    for (auto automation : { false, true })
+                    {
+                        auto result = runConfig({ sampleRate, blockSize, numChannels, &bandStates, automation },
+                            source,
+                            secondsPerConfig);
+
+                        if (!result.isVoid())
+                            configs.add(result);
+                    }
+                }
+            }
+        }
+    }
+
+    auto* results = new juce::DynamicObject();
+    results->setProperty("secondsPerConfig", secondsPerConfig);
+    results->setProperty("configs", configs);
+    return juce::var(results);
+}
@@ -0,0 +1,20 @@
+/*
+  ==============================================================================
+
+    ProcessBenchmark.h
+    Created: 19 Oct 2026 9:48:05pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ runs processBlock without an editor over every combination of sample rate (44.1 to 192kHz),
+ block size (16 to 4096), mono/stereo, the band states in getBandStateScenarios() and
+ automation on/off, for 'secondsPerConfig' of noise each.
+ every config reports ns/sample, p50/p99/max block time and the real-time factor.
+ */
+juce::var runProcessBenchmark(double secondsPerConfig);
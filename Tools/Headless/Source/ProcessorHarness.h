@@ -0,0 +1,105 @@
+/*
+  ==============================================================================
+
+    ProcessorHarness.h
+    Created: 19 Oct 2026 9:48:05pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "../../../Source/PluginProcessor.h"
+
+/*
+ helpers for driving a SimpleMBCompAudioProcessor the way a host would, without one.
+ */
+
+//sets a mono or stereo layout and calls prepareToPlay. returns false if the layout was refused.
+inline bool prepareProcessor(SimpleMBCompAudioProcessor& processor, double sampleRate, int blockSize, int numChannels)
+{
+    auto channelSet = numChannels == 1 ? juce::AudioChannelSet::mono() : juce::AudioChannelSet::stereo();
+
+    juce::AudioProcessor::BusesLayout layout;
+    layout.inputBuses.add(channelSet);
+    layout.outputBuses.add(channelSet);
+
+    if (!processor.setBusesLayout(layout))
+        return false;
+
+    processor.setRateAndBufferSizeDetails(sampleRate, blockSize);
+    processor.prepareToPlay(sampleRate, blockSize);
+    return true;
+}
+
+//'value' is in the parameter's own units, sent the way host automation would be.
+inline void setParameter(SimpleMBCompAudioProcessor& processor, Params::Names name, float value)
+{
+    auto* param = processor.paramRegistry.get<juce::RangedAudioParameter>(name);
+    param->setValueNotifyingHost(param->convertTo0to1(value));
+}
+
+//solo, mute and bypass for each band, low to high.
+struct BandStates
+{
+    const char* name;
+    std::array<bool, 3> solo, mute, bypass;
+};
+
+inline const std::array<BandStates, 5>& getBandStateScenarios()
+{
+    static const std::array<BandStates, 5> scenarios
+    {{
+        { "allActive",   { false, false, false }, { false, false, false }, { false, false, false } },
+        { "midSolo",     { false, true,  false }, { false, false, false }, { false, false, false } },
+        { "lowMute",     { false, false, false }, { true,  false, false }, { false, false, false } },
+        { "allBypassed", { false, false, false }, { false, false, false }, { true,  true,  true  } },
+        { "mixed",       { false, true,  false }, { false, false, true  }, { true,  false, false } }
+    }};
+
+    return scenarios;
+}
+
+inline void applyBandStates(SimpleMBCompAudioProcessor& processor, const BandStates& states)
+{
+    using namespace Params;
+    const Names solo[] = { Solo_Low_Band, Solo_Mid_Band, Solo_High_Band };
+    const Names mute[] = { Mute_Low_Band, Mute_Mid_Band, Mute_High_Band };
+    const Names bypass[] = { Bypass_Low_Band, Bypass_Mid_Band, Bypass_High_Band };
+
+    for (size_t band = 0; band < 3; ++band)
+    {
+        setParameter(processor, solo[band], states.solo[band] ? 1.f : 0.f);
+        setParameter(processor, mute[band], states.mute[band] ? 1.f : 0.f);
+        setParameter(processor, bypass[band], states.bypass[band] ? 1.f : 0.f);
+    }
+}
+
+/*
+ moves the crossovers, thresholds and input gain a little every block, like a slow LFO
+ drawn in as automation. 'phase' is in cycles.
+ */
+inline void applyAutomation(SimpleMBCompAudioProcessor& processor, double phase)
+{
+    using namespace Params;
+    auto lfo = (float)std::sin(juce::MathConstants<double>::twoPi * phase);
+
+    setParameter(processor, Low_Mid_Crossover_Freq, 400.f + 300.f * lfo);
+    setParameter(processor, Mid_High_Crossover_Freq, 4000.f + 2000.f * lfo);
+    setParameter(processor, Threshold_Low_Band, -20.f + 10.f * lfo);
+    setParameter(processor, Threshold_Mid_Band, -20.f - 10.f * lfo);
+    setParameter(processor, Threshold_High_Band, -20.f + 5.f * lfo);
+    setParameter(processor, Gain_In, 3.f * lfo);
+}
+
+inline void fillWithNoise(juce::AudioBuffer<float>& buffer, float amplitude, juce::int64 seed)
+{
+    juce::Random r(seed);
+    for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+    {
+        auto* samples = buffer.getWritePointer(ch);
+        for (int i = 0; i < buffer.getNumSamples(); ++i)
+            samples[i] = amplitude * (r.nextFloat() * 2.f - 1.f);
+    }
+}
@@ -0,0 +1,97 @@
+/*
+  ==============================================================================
+
+    ProfileTrace.cpp
+    Created: 19 Oct 2026 11:06:31pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "ProfileTrace.h"
+#include "ProcessorHarness.h"
+#include "../../../Source/DSP/Profiling.h"
+
+namespace
+{
+juce::var makeError(const juce::String& message)
+{
+    auto* result = new juce::DynamicObject();
+    result->setProperty("error", message);
+    return juce::var(result);
+}
+}
+
+juce::var runProfileTrace(const juce::File& outputFile, double seconds)
+{
+   #if SIMPLEMBCOMP_PROFILING
+    constexpr double sampleRate = 48000.0;
+    constexpr int blockSize = 512;
+    constexpr int numChannels = 2;
+
+    SimpleMBCompAudioProcessor processor;
+    if (!prepareProcessor(processor, sampleRate, blockSize, numChannels))
+        return makeError("couldn't prepare the processor");
+
+    for (int tap = 0; tap < NumAnalyzerTaps; ++tap)
+        processor.addAnalyzerSubscriber(static_cast<AnalyzerTap>(tap));
+
+    juce::AudioBuffer<float> source(numChannels, 1 << 16);
+    fillWithNoise(source, 0.5f, 1234);
+
+    juce::AudioBuffer<float> buffer(numChannels, blockSize), drainedAudio;
+    juce::MidiBuffer midi;
+    int readPosition = 0;
+
+    //registers this thread's ring now rather than inside the first timed block.
+    Profiling::getThreadRing().threadName = "audio";
+
+    Profiling::TraceWriter writer(outputFile);
+    if (!writer.start())
+        return makeError("couldn't open " + outputFile.getFullPathName());
+
+    const auto numBlocks = juce::jmax(1, (int)(seconds * sampleRate / blockSize));
+    for (int i = 0; i < numBlocks; ++i)
+    {
+        if (readPosition + blockSize > source.getNumSamples())
+            readPosition = 0;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.copyFrom(ch, 0, source, ch, readPosition, blockSize);
+
+        readPosition += blockSize;
+
+        applyAutomation(processor, (double)i / (double)numBlocks);
+        processor.processBlock(buffer, midi);
+
+        //what the editor would pull, so the fifos keep being fed.
+        for (auto& tap : processor.analyzerTaps)
+        {
+            for (auto* fifo : { &tap.left, &tap.right })
+            {
+                while (fifo->getNumCompleteBuffersAvailable() > 0)
+                    fifo->getAudioBuffer(drainedAudio);
+            }
+        }
+
+        processor.meterFrames.pullAll([](const MeterFrame&) {});
+    }
+
+    writer.stop();
+
+    for (int tap = 0; tap < NumAnalyzerTaps; ++tap)
+        processor.removeAnalyzerSubscriber(static_cast<AnalyzerTap>(tap));
+
+    processor.releaseResources();
+
+    auto* result = new juce::DynamicObject();
+    result->setProperty("file", outputFile.getFullPathName());
+    result->setProperty("blocks", numBlocks);
+    result->setProperty("eventsWritten", writer.getNumEventsWritten());
+    result->setProperty("eventsDropped", writer.getNumEventsDropped());
+    return juce::var(result);
+   #else
+    juce::ignoreUnused(outputFile, seconds);
+    return makeError("built without SIMPLEMBCOMP_PROFILING: use the Profile configuration");
+   #endif
+}
@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    ProfileTrace.h
+    Created: 19 Oct 2026 11:06:31pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ records 'seconds' of processBlock at 48kHz/512 stereo, with automation running and every
+ analyzer tap subscribed, into a Chrome trace (Profiling::TraceWriter) at 'outputFile'.
+ open it in chrome://tracing or ui.perfetto.dev to see the per-stage timers.
+ returns the number of events written and dropped, or an "error" property if no trace was
+ written (including in builds without SIMPLEMBCOMP_PROFILING).
+ */
+juce::var runProfileTrace(const juce::File& outputFile, double seconds);
@@ -0,0 +1,246 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyChecker.cpp
+    Created: 19 Oct 2026 10:21:47pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "RealtimeSafetyChecker.h"
+#include <JuceHeader.h>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+#if JUCE_LINUX && defined(__GLIBC__)
+ #define SIMPLEMBCOMP_INTERPOSE_LIBC 1
+ #include <dlfcn.h>
+ #include <pthread.h>
+ #include <semaphore.h>
+ #include <sched.h>
+ #include <time.h>
+ #include <unistd.h>
+#else
+ #define SIMPLEMBCOMP_INTERPOSE_LIBC 0
+#endif
+
+namespace RealtimeSafety
+{
+namespace
+{
+    //plain types only: these are read from inside malloc, before anything could be constructed.
+    thread_local bool inRealtimeSection = false;
+    thread_local bool isReporting = false;
+
+    std::atomic<ViolationAction> violationAction{ ViolationAction::Log };
+    std::array<std::atomic<int>, NumViolationKinds> violationCounts{};
+
+    //traces are expensive and long: enough to find the culprit, the counts cover the rest.
+    constexpr int maxTracesLogged = 10;
+    std::atomic<int> tracesLogged{ 0 };
+
+    void report(ViolationKind kind, const char* what)
+    {
+        violationCounts[kind].fetch_add(1);
+
+        //reporting allocates and writes, none of which should count.
+        isReporting = true;
+
+        auto shouldAbort = violationAction.load() == ViolationAction::Abort;
+        if (shouldAbort || tracesLogged.fetch_add(1) < maxTracesLogged)
+        {
+            std::cerr << "real-time safety violation: " << getViolationKindName(kind) << " (" << what << ")\n"
+                      << juce::SystemStats::getStackBacktrace() << std::endl;
+        }
+
+        if (shouldAbort)
+            std::abort();
+
+        isReporting = false;
+    }
+
+    inline void check(ViolationKind kind, const char* what)
+    {
+        if (inRealtimeSection && !isReporting)
+            report(kind, what);
+    }
+}
+
+const char* getViolationKindName(ViolationKind kind)
+{
+    switch (kind)
+    {
+        case Allocation:    return "allocation";
+        case Deallocation:  return "deallocation";
+        case Lock:          return "lock";
+        case SystemCall:    return "system call";
+        default:            return "unknown";
+    }
+}
+
+void setViolationAction(ViolationAction action)
+{
+    violationAction.store(action);
+}
+
+ScopedRealtimeSection::ScopedRealtimeSection()
+{
+    inRealtimeSection = true;
+}
+
+ScopedRealtimeSection::~ScopedRealtimeSection()
+{
+    inRealtimeSection = false;
+}
+
+std::array<int, NumViolationKinds> getViolationCounts()
+{
+    std::array<int, NumViolationKinds> counts{};
+    for (size_t i = 0; i < counts.size(); ++i)
+        counts[i] = violationCounts[i].load();
+
+    return counts;
+}
+
+void resetViolationCounts()
+{
+    for (auto& count : violationCounts)
+        count.store(0);
+
+    tracesLogged.store(0);
+}
+}
+
+//==============================================================================
+/*
+ with glibc, malloc and friends are checked directly (operator new ends up there too).
+ elsewhere only operator new and delete can be seen.
+ */
+#if SIMPLEMBCOMP_INTERPOSE_LIBC
+extern "C"
+{
+    void* __libc_malloc(size_t);
+    void* __libc_calloc(size_t, size_t);
+    void* __libc_realloc(void*, size_t);
+    void __libc_free(void*);
+
+    void* malloc(size_t size) noexcept
+    {
+        RealtimeSafety::check(RealtimeSafety::Allocation, "malloc");
+        return __libc_malloc(size);
+    }
+
+    void* calloc(size_t count, size_t size) noexcept
+    {
+        RealtimeSafety::check(RealtimeSafety::Allocation, "calloc");
+        return __libc_calloc(count, size);
+    }
+
+    void* realloc(void* ptr, size_t size) noexcept
+    {
+        RealtimeSafety::check(RealtimeSafety::Allocation, "realloc");
+        return __libc_realloc(ptr, size);
+    }
+
+    void free(void* ptr) noexcept
+    {
+        if (ptr != nullptr)
+            RealtimeSafety::check(RealtimeSafety::Deallocation, "free");
+
+        __libc_free(ptr);
+    }
+}
+
+namespace
+{
+    /*
+     the next definition of 'name' after ours. cached in a constant-initialised atomic
+     rather than a function static, whose guard could itself take a lock.
+     */
+    template<typename Fn>
+    Fn getNextSymbol(std::atomic<void*>& cache, const char* name)
+    {
+        auto* fn = cache.load(std::memory_order_relaxed);
+        if (fn == nullptr)
+        {
+            fn = dlsym(RTLD_NEXT, name);
+            cache.store(fn, std::memory_order_relaxed);
+        }
+
+        return reinterpret_cast<Fn>(fn);
+    }
+}
+
+//'spec' has to match the libc declaration: glibc marks the calls that aren't cancellation points noexcept.
+#define SIMPLEMBCOMP_INTERPOSE(kind, returnType, name, params, args, spec)                  \
+    extern "C" returnType name params spec                                                  \
+    {                                                                                       \
+        RealtimeSafety::check(RealtimeSafety::kind, #name);                                 \
+        static std::atomic<void*> next{ nullptr };                                          \
+        return getNextSymbol<returnType (*) params>(next, #name) args;                      \
+    }
+
+SIMPLEMBCOMP_INTERPOSE(Lock, int, pthread_mutex_lock, (pthread_mutex_t* m), (m), noexcept)
+SIMPLEMBCOMP_INTERPOSE(Lock, int, pthread_cond_wait, (pthread_cond_t* c, pthread_mutex_t* m), (c, m), )
+SIMPLEMBCOMP_INTERPOSE(Lock, int, pthread_rwlock_rdlock, (pthread_rwlock_t* l), (l), noexcept)
+SIMPLEMBCOMP_INTERPOSE(Lock, int, pthread_rwlock_wrlock, (pthread_rwlock_t* l), (l), noexcept)
+SIMPLEMBCOMP_INTERPOSE(Lock, int, sem_wait, (sem_t* s), (s), )
+
+SIMPLEMBCOMP_INTERPOSE(SystemCall, ssize_t, read, (int fd, void* buf, size_t count), (fd, buf, count), )
+SIMPLEMBCOMP_INTERPOSE(SystemCall, ssize_t, write, (int fd, const void* buf, size_t count), (fd, buf, count), )
+SIMPLEMBCOMP_INTERPOSE(SystemCall, int, nanosleep, (const struct timespec* req, struct timespec* rem), (req, rem), )
+SIMPLEMBCOMP_INTERPOSE(SystemCall, int, usleep, (useconds_t usec), (usec), )
+SIMPLEMBCOMP_INTERPOSE(SystemCall, int, sched_yield, (), (), noexcept)
+
+#undef SIMPLEMBCOMP_INTERPOSE
+#endif
+
+//==============================================================================
+namespace
+{
+    void* checkedNew(std::size_t size)
+    {
+       #if ! SIMPLEMBCOMP_INTERPOSE_LIBC
+        RealtimeSafety::check(RealtimeSafety::Allocation, "operator new");
+       #endif
+
+        if (auto* ptr = std::malloc(size == 0 ? 1 : size))
+            return ptr;
+
+        throw std::bad_alloc();
+    }
+
+    void checkedDelete(void* ptr) noexcept
+    {
+       #if ! SIMPLEMBCOMP_INTERPOSE_LIBC
+        if (ptr != nullptr)
+            RealtimeSafety::check(RealtimeSafety::Deallocation, "operator delete");
+       #endif
+
+        std::free(ptr);
+    }
+}
+
+void* operator new(std::size_t size) { return checkedNew(size); }
+void* operator new[](std::size_t size) { return checkedNew(size); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return checkedNew(size); }
+    catch (...) { return nullptr; }
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    try { return checkedNew(size); }
+    catch (...) { return nullptr; }
+}
+
+void operator delete(void* ptr) noexcept { checkedDelete(ptr); }
+void operator delete[](void* ptr) noexcept { checkedDelete(ptr); }
+void operator delete(void* ptr, std::size_t) noexcept { checkedDelete(ptr); }
+void operator delete[](void* ptr, std::size_t) noexcept { checkedDelete(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { checkedDelete(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { checkedDelete(ptr); }
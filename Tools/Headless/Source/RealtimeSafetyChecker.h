@@ -0,0 +1,55 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyChecker.h
+    Created: 19 Oct 2026 10:21:47pm
+    Author:  brand
+
+    Catches work that must never happen on the audio thread while a
+    ScopedRealtimeSection is open on the calling thread:
+    - operator new / delete everywhere,
+    - malloc, calloc, realloc and free with glibc,
+    - pthread mutex, condition variable and semaphore waits, plus read, write
+      and the sleep / yield calls on Linux, by interposing the libc symbols.
+
+    Other threads are never checked, so a GUI thread can keep allocating.
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <array>
+#include <atomic>
+
+namespace RealtimeSafety
+{
+    enum ViolationKind
+    {
+        Allocation,
+        Deallocation,
+        Lock,
+        SystemCall,
+        NumViolationKinds
+    };
+
+    const char* getViolationKindName(ViolationKind kind);
+
+    enum class ViolationAction
+    {
+        Log,    //stderr, with a stack trace for the first few
+        Abort   //stderr and stack trace, then std::abort()
+    };
+
+    void setViolationAction(ViolationAction action);
+
+    //marks the calling thread as real-time until it goes out of scope.
+    struct ScopedRealtimeSection
+    {
+        ScopedRealtimeSection();
+        ~ScopedRealtimeSection();
+    };
+
+    //violations on any thread since the last reset.
+    std::array<int, NumViolationKinds> getViolationCounts();
+    void resetViolationCounts();
+}
@@ -0,0 +1,196 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyTest.cpp
+    Created: 19 Oct 2026 10:21:47pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "RealtimeSafetyTest.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+struct TestContext
+{
+    SimpleMBCompAudioProcessor processor;
+    juce::AudioBuffer<float> source{ 2, 1 << 16 };
+    juce::AudioBuffer<float> buffer;
+    juce::MidiBuffer midi;
+    int readPosition = 0;
+
+    //what the editor would pull on the message thread.
+    juce::AudioBuffer<float> drainedAudio;
+
+    TestContext()
+    {
+        fillWithNoise(source, 0.5f, 4321);
+    }
+
+    bool prepare(double sampleRate, int blockSize, int numChannels)
+    {
+        if (!prepareProcessor(processor, sampleRate, blockSize, numChannels))
+            return false;
+
+        buffer.setSize(numChannels, blockSize);
+        return true;
+    }
+
+    void processBlock(int numSamples)
+    {
+        processBlock(numSamples, []() {});
+    }
+
+    //'beforeProcessing' runs inside the same real-time section, like a host changing parameters on its audio thread.
+    template<typename Fn>
+    void processBlock(int numSamples, Fn&& beforeProcessing)
+    {
+        numSamples = juce::jmin(numSamples, buffer.getNumSamples());
+
+        if (readPosition + numSamples > source.getNumSamples())
+            readPosition = 0;
+
+        //the host hands over a buffer of exactly 'numSamples', allocated before the callback.
+        juce::AudioBuffer<float> hostBuffer(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), numSamples);
+        for (int ch = 0; ch < hostBuffer.getNumChannels(); ++ch)
+            hostBuffer.copyFrom(ch, 0, source, ch, readPosition, numSamples);
+
+        readPosition += numSamples;
+
+        {
+            RealtimeSafety::ScopedRealtimeSection section;
+            beforeProcessing();
+            processor.processBlock(hostBuffer, midi);
+        }
+
+        drain();
+    }
+
+    void drain()
+    {
+        for (auto& tap : processor.analyzerTaps)
+        {
+            for (auto* fifo : { &tap.left, &tap.right })
+            {
+                while (fifo->getNumCompleteBuffersAvailable() > 0)
+                    fifo->getAudioBuffer(drainedAudio);
+            }
+        }
+
+        processor.meterFrames.pullAll([](const MeterFrame&) {});
+    }
+
+    void setAllTapsSubscribed(bool shouldBeSubscribed)
+    {
+        for (int tap = 0; tap < NumAnalyzerTaps; ++tap)
+        {
+            if (shouldBeSubscribed)
+                processor.addAnalyzerSubscriber(static_cast<AnalyzerTap>(tap));
+            else
+                processor.removeAnalyzerSubscriber(static_cast<AnalyzerTap>(tap));
+        }
+    }
+};
+
+juce::var toVar(const std::array<int, RealtimeSafety::NumViolationKinds>& counts, int& total)
+{
+    auto* obj = new juce::DynamicObject();
+    for (int kind = 0; kind < RealtimeSafety::NumViolationKinds; ++kind)
+    {
+        obj->setProperty(RealtimeSafety::getViolationKindName(static_cast<RealtimeSafety::ViolationKind>(kind)), counts[(size_t)kind]);
+        total += counts[(size_t)kind];
+    }
+
+    return juce::var(obj);
+}
+}
+
+juce::var runRealtimeSafetyTest(RealtimeSafety::ViolationAction action)
+{
+    RealtimeSafety::setViolationAction(action);
+
+    auto* cases = new juce::DynamicObject();
+    int total = 0;
+
+    auto runCase = [&cases, &total](const juce::String& name, auto&& body)
+    {
+        RealtimeSafety::resetViolationCounts();
+        body();
+        cases->setProperty(name, toVar(RealtimeSafety::getViolationCounts(), total));
+    };
+
+    for (auto numChannels : { 1, 2 })
+    {
+        const auto suffix = numChannels == 1 ? juce::String("Mono") : juce::String("Stereo");
+
+        TestContext context;
+        if (!context.prepare(48000.0, 512, numChannels))
+            continue;
+
+        context.setAllTapsSubscribed(true);
+
+        runCase("steady" + suffix, [&context]()
+            {
+                for (int i = 0; i < 200; ++i)
+                    context.processBlock(512);
+            });
+
+        runCase("shorterBlocks" + suffix, [&context]()
+            {
+                for (auto numSamples : { 1, 17, 64, 255, 511, 512, 3, 512 })
+                    context.processBlock(numSamples);
+            });
+
+        runCase("automation" + suffix, [&context]()
+            {
+                for (int i = 0; i < 200; ++i)
+                    context.processBlock(512, [&context, i]() { applyAutomation(context.processor, i / 200.0); });
+            });
+
+        runCase("bandStates" + suffix, [&context]()
+            {
+                //every scenario after every other one, so each transition is covered.
+                for (const auto& from : getBandStateScenarios())
+                {
+                    for (const auto& to : getBandStateScenarios())
+                    {
+                        context.processBlock(512, [&context, &from]() { applyBandStates(context.processor, from); });
+                        context.processBlock(512, [&context, &to]() { applyBandStates(context.processor, to); });
+                    }
+                }
+
+                applyBandStates(context.processor, getBandStateScenarios().front());
+            });
+
+        runCase("analyzerSubscriptions" + suffix, [&context]()
+            {
+                for (int i = 0; i < 20; ++i)
+                    context.processBlock(512, [&context, i]() { context.setAllTapsSubscribed(i % 2 != 0); });
+            });
+
+        runCase("sampleRateChanges" + suffix, [&context, numChannels]()
+            {
+                for (auto [sampleRate, blockSize] : { std::pair<double, int>{ 96000.0, 1024 },
+                                                      std::pair<double, int>{ 44100.0, 256 },
+                                                      std::pair<double, int>{ 192000.0, 4096 },
+                                                      std::pair<double, int>{ 48000.0, 16 } })
+                {
+                    context.processor.releaseResources();
+                    context.prepare(sampleRate, blockSize, numChannels);
+
+                    for (int i = 0; i < 50; ++i)
+                        context.processBlock(blockSize);
+                }
+            });
+
+        context.setAllTapsSubscribed(false);
+    }
+
+    auto* results = new juce::DynamicObject();
+    results->setProperty("cases", juce::var(cases));
+    results->setProperty("totalViolations", total);
+    results->setProperty("passed", total == 0);
+    return juce::var(results);
+}
@@ -0,0 +1,26 @@
+/*
+  ==============================================================================
+
+    RealtimeSafetyTest.h
+    Created: 19 Oct 2026 10:21:47pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+#include "RealtimeSafetyChecker.h"
+
+/*
+ drives processBlock through every path a host can take it down, each block inside a
+ RealtimeSafety::ScopedRealtimeSection: steady state, blocks shorter than prepared,
+ automation, solo/mute/bypass changes, sample rate and block size changes, and the
+ analyzer taps being subscribed, unsubscribed and drained.
+
+ parameter changes and analyzer (un)subscriptions run inside the section, in the same
+ block as processBlock, since hosts drive automation and its listeners from the audio thread.
+ prepareToPlay and reading the fifos happen outside it, like they would on another thread.
+ returns the violations per case; 'passed' is false if there were any.
+ */
+juce::var runRealtimeSafetyTest(RealtimeSafety::ViolationAction action);
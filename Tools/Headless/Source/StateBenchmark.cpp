@@ -0,0 +1,71 @@
+/*
+  ==============================================================================
+
+    StateBenchmark.cpp
+    Created: 20 Oct 2026 1:51:04am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "StateBenchmark.h"
+#include "BenchmarkUtilities.h"
+#include "ProcessorHarness.h"
+
+juce::var runStateBenchmark(int iterations)
+{
+    const auto warmup = juce::jmax(1, iterations / 10);
+    auto* results = new juce::DynamicObject();
+
+    SimpleMBCompAudioProcessor processor;
+    juce::MemoryBlock block;
+
+    results->setProperty("getStateBinary", toVar(runBenchmark(iterations, warmup, [&processor, &block]()
+        {
+            processor.getStateInformation(block);
+        })));
+
+    //what getStateInformation() wrote before the binary format.
+    auto writeValueTree = [&processor](juce::MemoryBlock& dest)
+    {
+        juce::MemoryOutputStream mos(dest, false);
+        processor.apvts.copyState().writeToStream(mos);
+    };
+
+    results->setProperty("getStateValueTree", toVar(runBenchmark(iterations, warmup, [&writeValueTree, &block]()
+        {
+            block.reset();
+            writeValueTree(block);
+        })));
+
+    juce::MemoryBlock current, changed, legacy;
+    processor.getStateInformation(current);
+    writeValueTree(legacy);
+
+    setParameter(processor, Params::Threshold_Mid_Band, -30.f);
+    processor.getStateInformation(changed);
+    setParameter(processor, Params::Threshold_Mid_Band, 0.f);
+
+    results->setProperty("binaryBytes", (int)current.getSize());
+    results->setProperty("valueTreeBytes", (int)legacy.getSize());
+
+    results->setProperty("restoreUnchanged", toVar(runBenchmark(iterations, warmup, [&processor, &current]()
+        {
+            processor.setStateInformation(current.getData(), (int)current.getSize());
+        })));
+
+    //alternates between the two, so every restore changes one parameter.
+    int restores = 0;
+    results->setProperty("restoreOneChanged", toVar(runBenchmark(iterations, warmup, [&processor, &current, &changed, &restores]()
+        {
+            auto& state = (restores++ % 2 == 0) ? changed : current;
+            processor.setStateInformation(state.getData(), (int)state.getSize());
+        })));
+
+    results->setProperty("restoreValueTree", toVar(runBenchmark(iterations, warmup, [&processor, &legacy]()
+        {
+            processor.setStateInformation(legacy.getData(), (int)legacy.getSize());
+        })));
+
+    return juce::var(results);
+}
@@ -0,0 +1,20 @@
+/*
+  ==============================================================================
+
+    StateBenchmark.h
+    Created: 20 Oct 2026 1:51:04am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ times getStateInformation() and setStateInformation() with the binary StateFormat, next to
+ the ValueTree state the plugin used to save: restoring the state it already has, restoring
+ one with a single parameter changed, and restoring an old ValueTree blob.
+ also reports both blobs' sizes.
+ */
+juce::var runStateBenchmark(int iterations);
@@ -0,0 +1,107 @@
+/*
+  ==============================================================================
+
+    TraceBenchmark.cpp
+    Created: 19 Oct 2026 4:58:13pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "TraceBenchmark.h"
+#include "BenchmarkUtilities.h"
+#include "../../../Source/GUI/AnalyzerPathGenerator.h"
+#include "../../../Source/GUI/SpectrumTraceRenderer.h"
+
+namespace
+{
+//a pink-ish slope with some noise, in dB.
+std::vector<float> makeSpectrum(int numBins, int seed)
+{
+    juce::Random r(seed);
+    std::vector<float> data((size_t)numBins);
+    for (int bin = 0; bin < numBins; ++bin)
+    {
+        auto slope = -3.f * std::log2((float)juce::jmax(1, bin));
+        data[(size_t)bin] = juce::jmax((float)NEGATIVE_INFINITY, slope + r.nextFloat() * 12.f - 6.f);
+    }
+
+    return data;
+}
+}
+
+juce::var runTraceBenchmark(int iterations)
+{
+    constexpr int fftSize = 8192;
+    constexpr float sampleRate = 48000.f;
+    constexpr int height = 200;
+    const auto warmup = juce::jmax(1, iterations / 10);
+
+    const std::vector<std::vector<float>> spectra { makeSpectrum(fftSize / 2, 1), makeSpectrum(fftSize / 2, 2) };
+
+    auto* results = new juce::DynamicObject();
+
+    for (auto width : { 550, 2000 })
+    {
+        //the same layout the analyzer uses: x relative to the area, y relative to the component.
+        const juce::Rectangle<int> area(20, 20, width, height);
+        const auto fftBounds = area.toFloat();
+
+        std::vector<juce::Path> paths(spectra.size());
+        std::vector<SpectrumTrace> traces(spectra.size());
+
+        for (size_t i = 0; i < spectra.size(); ++i)
+        {
+            AnalyzerPathGenerator<juce::Path> pathGenerator;
+            pathGenerator.generatePath(spectra[i], fftBounds, fftSize, sampleRate / fftSize, NEGATIVE_INFINITY);
+            pathGenerator.getPath(paths[i]);
+
+            AnalyzerPathGenerator<SpectrumTrace> traceGenerator;
+            traceGenerator.generatePath(spectra[i], fftBounds, fftSize, sampleRate / fftSize, NEGATIVE_INFINITY);
+            traceGenerator.getPath(traces[i]);
+        }
+
+        juce::Image frame(juce::Image::RGB, area.getRight(), area.getBottom(), true);
+
+        auto strokePaths = runBenchmark(iterations, warmup, [&]()
+        {
+            juce::Graphics g(frame);
+            juce::Graphics::ScopedSaveState sss(g);
+            g.reduceClipRegion(area);
+
+            for (const auto& source : paths)
+            {
+                auto path = source;
+                path.applyTransform(juce::AffineTransform().translation((float)area.getX(), 0));
+                g.setColour(juce::Colours::forestgreen);
+                g.strokePath(path, juce::PathStrokeType(1.f));
+            }
+        });
+
+        auto* widthResult = new juce::DynamicObject();
+        widthResult->setProperty("strokePath", toVar(strokePaths));
+
+        for (auto antiAliased : { true, false })
+        {
+            SpectrumTraceRenderer renderer;
+            renderer.setAntiAliased(antiAliased);
+
+            auto raster = runBenchmark(iterations, warmup, [&]()
+            {
+                juce::Graphics g(frame);
+                renderer.begin(area.getWidth(), area.getHeight(), 1.f);
+
+                for (const auto& trace : traces)
+                    renderer.drawTrace(trace, -(float)area.getY(), juce::Colours::forestgreen);
+
+                renderer.draw(g, area);
+            });
+
+            widthResult->setProperty(antiAliased ? "rasterAntiAliased" : "raster", toVar(raster));
+        }
+
+        results->setProperty(juce::String(width) + "px", juce::var(widthResult));
+    }
+
+    return juce::var(results);
+}
@@ -0,0 +1,19 @@
+/*
+  ==============================================================================
+
+    TraceBenchmark.h
+    Created: 19 Oct 2026 4:58:13pm
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ draws a left/right pair of 8192 point spectra the way SpectrumAnalyzer used to
+ (copy the juce::Path, translate, strokePath) and with SpectrumTraceRenderer,
+ at the editor's 550px width and at 2000px.
+ */
+juce::var runTraceBenchmark(int iterations);
@@ -0,0 +1,110 @@
+/*
+  ==============================================================================
+
+    TransferFunctionTest.cpp
+    Created: 20 Oct 2026 1:09:53am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#include "TransferFunctionTest.h"
+#include "ProcessorHarness.h"
+
+namespace
+{
+juce::var toVar(const std::vector<float>& values)
+{
+    juce::Array<juce::var> array;
+    for (auto value : values)
+        array.add(value);
+
+    return juce::var(array);
+}
+
+float groupDelayAt(const TransferFunctionMeasurement::Response& response, float frequency)
+{
+    auto nearest = std::min_element(response.frequencies.begin(), response.frequencies.end(),
+                                    [frequency](float a, float b) { return std::abs(a - frequency) < std::abs(b - frequency); });
+
+    return response.groupDelayMs[(size_t)std::distance(response.frequencies.begin(), nearest)];
+}
+}
+
+juce::var runTransferFunctionTest(double sampleRate, float toleranceDb, bool includeCurves)
+{
+    constexpr int blockSize = 512;
+
+    struct Crossovers { float lowMid, midHigh; };
+    const Crossovers crossovers[] = { { 200.f, 2000.f }, { 100.f, 1000.f }, { 500.f, 8000.f }, { 999.f, 1000.f } };
+
+    juce::Array<juce::var> cases;
+    bool allPassed = true;
+
+    for (auto bypassed : { true, false })
+    {
+        for (const auto& crossover : crossovers)
+        {
+            SimpleMBCompAudioProcessor processor;
+
+            using namespace Params;
+            setParameter(processor, Low_Mid_Crossover_Freq, crossover.lowMid);
+            setParameter(processor, Mid_High_Crossover_Freq, crossover.midHigh);
+
+            //the sweep peaks at -12dBFS, so thresholds at 0dB leave running compressors doing nothing.
+            for (auto name : { Bypass_Low_Band, Bypass_Mid_Band, Bypass_High_Band })
+                setParameter(processor, name, bypassed ? 1.f : 0.f);
+
+            for (auto name : { Threshold_Low_Band, Threshold_Mid_Band, Threshold_High_Band })
+                setParameter(processor, name, 0.f);
+
+            if (!prepareProcessor(processor, sampleRate, blockSize, 2))
+                continue;
+
+            juce::AudioBuffer<float> buffer(2, blockSize);
+            juce::MidiBuffer midi;
+
+            processor.measurement.start();
+            while (!processor.measurement.isComplete())
+            {
+                buffer.clear();
+                processor.processBlock(buffer, midi);
+            }
+
+            auto response = processor.measurement.computeResponse();
+            processor.releaseResources();
+
+            auto [minIt, maxIt] = std::minmax_element(response.magnitudedB.begin(), response.magnitudedB.end());
+            auto maxDeviation = juce::jmax(std::abs(*minIt), std::abs(*maxIt));
+            auto passed = maxDeviation <= toleranceDb;
+            allPassed = allPassed && passed;
+
+            auto* result = new juce::DynamicObject();
+            result->setProperty("compressors", bypassed ? "bypassed" : "belowThreshold");
+            result->setProperty("lowMidCrossover", crossover.lowMid);
+            result->setProperty("midHighCrossover", crossover.midHigh);
+            result->setProperty("minMagnitudedB", *minIt);
+            result->setProperty("maxMagnitudedB", *maxIt);
+            result->setProperty("groupDelayAtLowMidMs", groupDelayAt(response, crossover.lowMid));
+            result->setProperty("groupDelayAtMidHighMs", groupDelayAt(response, crossover.midHigh));
+            result->setProperty("passed", passed);
+
+            if (includeCurves)
+            {
+                result->setProperty("frequencies", toVar(response.frequencies));
+                result->setProperty("magnitudedB", toVar(response.magnitudedB));
+                result->setProperty("phaseDegrees", toVar(response.phaseDegrees));
+                result->setProperty("groupDelayMs", toVar(response.groupDelayMs));
+            }
+
+            cases.add(juce::var(result));
+        }
+    }
+
+    auto* results = new juce::DynamicObject();
+    results->setProperty("sampleRate", sampleRate);
+    results->setProperty("toleranceDb", toleranceDb);
+    results->setProperty("cases", cases);
+    results->setProperty("passed", allPassed);
+    return juce::var(results);
+}
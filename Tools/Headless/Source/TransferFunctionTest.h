@@ -0,0 +1,21 @@
+/*
+  ==============================================================================
+
+    TransferFunctionTest.h
+    Created: 20 Oct 2026 1:09:53am
+    Author:  brand
+
+  ==============================================================================
+*/
+
+#pragma once
+#include <JuceHeader.h>
+
+/*
+ sweeps the processor with its TransferFunctionMeasurement at several crossover settings,
+ with every band bypassed and with the compressors running below their thresholds.
+ the LR4 bands should sum flat, so each case passes if the magnitude stays within
+ 'toleranceDb' of 0dB across the sweep. also reports the group delay at each crossover
+ and, with 'includeCurves', the full magnitude/phase/group delay curves.
+ */
+juce::var runTransferFunctionTest(double sampleRate, float toleranceDb, bool includeCurves);
@@ -0,0 +1,32 @@
+#!/bin/sh
+# Checks the plugin's audio against the reference set checked in at golden/references.json.
+#
+#   golden.sh <headless binary> [--max-abs=X] [--max-envelope-db=dB]
+#   golden.sh --record <headless binary>
+#
+# --record rewrites the reference set with the given build. Do that only for a change that is
+# meant to alter the audio, and commit the new file with it (see GoldenAudioTest.h).
+
+set -e
+
+references="$(cd "$(dirname "$0")" && pwd)/golden/references.json"
+
+if [ "$1" = "--record" ]; then
+    if [ $# -ne 2 ]; then
+        echo "usage: $0 --record <headless binary>" >&2
+        exit 2
+    fi
+
+    exec "$2" --golden --record --references="$references"
+fi
+
+if [ $# -lt 1 ]; then
+    echo "usage: $0 <headless binary> [--max-abs=X] [--max-envelope-db=dB]" >&2
+    echo "       $0 --record <headless binary>" >&2
+    exit 2
+fi
+
+binary=$1
+shift
+
+exec "$binary" --golden --references="$references" "$@"